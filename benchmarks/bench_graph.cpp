@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include "compressed_digraph.hpp"
+#include "lightweight_digraph.hpp"
+#include "lightweight_graph.hpp"
+#include "shapes.hpp"
+
+using namespace vpr;
+
+namespace {
+
+/**
+ * @brief Builds a graph with `emplace_node` and `addEdge`, letting the adjacency lists grow.
+ */
+template <typename GraphType>
+void BM_AddEdge(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const auto edges = shapes::graphEdges(shape, n);
+    for (auto _ : state) {
+        GraphType graph;
+        graph.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            graph.emplace_node(static_cast<int>(i));
+        }
+        for (const auto& edge : edges) {
+            graph.addEdge(edge.first, edge.second);
+        }
+        benchmark::DoNotOptimize(graph.size());
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size());
+    state.SetLabel(shapes::graphShapeName(shape));
+}
+
+/**
+ * @brief Visits every edge of every node, summing the targets.
+ */
+template <typename GraphType>
+size_t scanEdges(const GraphType& graph) {
+    size_t sum = 0;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        for (size_t target : graph.getNode(i).edges()) {
+            sum += target;
+        }
+    }
+    return sum;
+}
+
+template <typename GraphType>
+void BM_EdgeScan(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const GraphType graph = shapes::makeGraph<GraphType>(shape, n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scanEdges(graph));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(shapes::graphShapeName(shape));
+}
+
+void BM_CompressedEdgeScan(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const lightweight::CompressedDigraph<int> graph(shapes::makeGraph<lightweight::Digraph<int>>(shape, n));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scanEdges(graph));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(shapes::graphShapeName(shape));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_AddEdge, lightweight::Graph<int>)->Apply(shapes::GraphShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AddEdge, lightweight::Digraph<int>)->Apply(shapes::GraphShapesAndSizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_EdgeScan, lightweight::Graph<int>)->Apply(shapes::GraphShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EdgeScan, lightweight::Digraph<int>)->Apply(shapes::GraphShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CompressedEdgeScan)->Apply(shapes::GraphShapesAndSizes)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include "compressed_digraph.hpp"
+#include "lightweight_digraph.hpp"
+#include "lightweight_graph.hpp"
+#include "lightweight_tree.hpp"
+#include "shapes.hpp"
+#include "smart_tree.hpp"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace vpr;
+
+namespace {
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+/**
+ * @brief Bytes currently allocated on the heap, as reported by glibc.
+ *
+ * Large blocks such as the node and edge vectors are served by `mmap` and only show up in
+ * `hblkhd`, so both counters are summed.
+ */
+size_t heapInUse() {
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#define VPR_HAS_HEAP_STATS 1
+#endif
+
+/**
+ * @brief Reports the heap bytes per node held by a structure built with `build`.
+ *
+ * The structure is built once per iteration and its footprint is the difference in heap
+ * usage before and after; the timing is not meaningful.
+ */
+template <typename Build>
+void measureBytesPerNode(benchmark::State& state, size_t n, Build build) {
+#ifdef VPR_HAS_HEAP_STATS
+    double bytes = 0;
+    for (auto _ : state) {
+        const size_t before = heapInUse();
+        auto structure = build();
+        bytes = static_cast<double>(heapInUse() - before);
+        benchmark::DoNotOptimize(structure.size());
+    }
+    state.counters["bytes_per_node"] = bytes / static_cast<double>(n);
+    state.counters["total_bytes"] = bytes;
+#else
+    (void)n;
+    (void)build;
+    state.SkipWithError("Heap statistics need glibc 2.33 or later.");
+#endif
+}
+
+template <typename TreeType>
+struct BuildTree {
+    int64_t shape;
+    size_t n;
+    TreeType operator()() const { return shapes::makeTree<TreeType>(shape, n); }
+};
+
+template <typename GraphType>
+struct BuildGraph {
+    int64_t shape;
+    size_t n;
+    GraphType operator()() const { return shapes::makeGraph<GraphType>(shape, n); }
+};
+
+struct BuildCompressed {
+    int64_t shape;
+    size_t n;
+    lightweight::CompressedDigraph<int> operator()() const {
+        return lightweight::CompressedDigraph<int>(shapes::makeGraph<lightweight::Digraph<int>>(shape, n));
+    }
+};
+
+template <typename TreeType>
+void BM_TreeMemory(benchmark::State& state) {
+    const BuildTree<TreeType> build = { state.range(0), static_cast<size_t>(state.range(1)) };
+    measureBytesPerNode(state, build.n, build);
+    state.SetLabel(shapes::treeShapeName(build.shape));
+}
+
+template <typename GraphType>
+void BM_GraphMemory(benchmark::State& state) {
+    const BuildGraph<GraphType> build = { state.range(0), static_cast<size_t>(state.range(1)) };
+    measureBytesPerNode(state, build.n, build);
+    state.SetLabel(shapes::graphShapeName(build.shape));
+}
+
+void BM_CompressedDigraphMemory(benchmark::State& state) {
+    const BuildCompressed build = { state.range(0), static_cast<size_t>(state.range(1)) };
+    measureBytesPerNode(state, build.n, build);
+    state.SetLabel(shapes::graphShapeName(build.shape));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_TreeMemory, lightweight::Tree<int>)->Apply(shapes::TreeShapesAndSizes)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_TreeMemory, lightweight::StableTree<int>)->Apply(shapes::TreeShapesAndSizes)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_TreeMemory, smart::Tree<int>)->Apply(shapes::TreeShapesAndSizes)->Iterations(1);
+
+BENCHMARK_TEMPLATE(BM_GraphMemory, lightweight::Graph<int>)->Apply(shapes::GraphShapesAndSizes)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_GraphMemory, lightweight::Digraph<int>)->Apply(shapes::GraphShapesAndSizes)->Iterations(1);
+BENCHMARK(BM_CompressedDigraphMemory)->Apply(shapes::GraphShapesAndSizes)->Iterations(1);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include "bfs.hpp"
+#include "lightweight_digraph.hpp"
+
+using namespace vpr;
+
+namespace {
+
+/**
+ * @brief Random digraph with 2^20 nodes and an average out-degree of 16, built once.
+ */
+const lightweight::Digraph<int>& scalingGraph() {
+    static const lightweight::Digraph<int> graph = [] {
+        const size_t n = size_t(1) << 20;
+        lightweight::Digraph<int> g;
+        for (size_t i = 0; i < n; ++i) {
+            g.emplace_node(0);
+        }
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        for (size_t i = 0; i < 16 * n; ++i) {
+            g.addEdge(pick(rng), pick(rng));
+        }
+        return g;
+    }();
+    return graph;
+}
+
+void BM_SequentialBfs(benchmark::State& state) {
+    const auto& graph = scalingGraph();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithms::bfsDistances(graph, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * graph.size());
+}
+
+void BM_ParallelBfs(benchmark::State& state) {
+    const auto& graph = scalingGraph();
+    const size_t threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithms::parallelBfsDistances(graph, 0, threads));
+    }
+    state.SetItemsProcessed(state.iterations() * graph.size());
+}
+
+/**
+ * @brief Registers thread counts 1, 2, 4, ... up to the number of hardware threads.
+ */
+void ThreadCounts(benchmark::internal::Benchmark* bench) {
+    const size_t max = parallel::hardwareConcurrency();
+    for (size_t threads = 1; threads < max; threads *= 2) {
+        bench->Arg(static_cast<int64_t>(threads));
+    }
+    bench->Arg(static_cast<int64_t>(max));
+}
+
+} // namespace
+
+BENCHMARK(BM_SequentialBfs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ParallelBfs)->Apply(ThreadCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
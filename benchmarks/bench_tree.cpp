@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <utility>
+#include "lightweight_tree.hpp"
+#include "shapes.hpp"
+#include "smart_tree.hpp"
+
+using namespace vpr;
+
+namespace {
+
+/**
+ * @brief Builds a tree node by node with `addChild`, letting the storage grow.
+ */
+template <typename TreeType>
+void BM_AddChild(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const std::vector<size_t> parents = shapes::treeParents(shape, n);
+    for (auto _ : state) {
+        TreeType tree(0);
+        for (size_t i = 1; i < n; ++i) {
+            tree.addChild(parents[i], static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(shapes::treeShapeName(shape));
+}
+
+/**
+ * @brief Sums the node values in the order given by a pair of traversal iterators.
+ */
+template <typename Iterator>
+int64_t sumValues(Iterator it, Iterator end) {
+    int64_t sum = 0;
+    for (; it != end; ++it) {
+        sum += it->value();
+    }
+    return sum;
+}
+
+enum Traversal { PreOrder, PostOrder, Bfs, ReversePreOrder, ReverseBfs };
+
+template <typename TreeType, Traversal Order>
+int64_t traverse(const TreeType& tree) {
+    switch (Order) {
+    case PreOrder: return sumValues(tree.pre_order_begin(), tree.pre_order_end());
+    case PostOrder: return sumValues(tree.post_order_begin(), tree.post_order_end());
+    case Bfs: return sumValues(tree.bfs_begin(), tree.bfs_end());
+    case ReversePreOrder: return sumValues(tree.pre_order_rbegin(), tree.pre_order_rend());
+    default: return sumValues(tree.bfs_rbegin(), tree.bfs_rend());
+    }
+}
+
+template <typename TreeType, Traversal Order>
+void BM_Traversal(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const TreeType tree = shapes::makeTree<TreeType>(shape, n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(traverse<TreeType, Order>(tree));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(shapes::treeShapeName(shape));
+}
+
+void BM_SmartTreeCopy(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const smart::Tree<int> tree = shapes::makeTree<smart::Tree<int>>(shape, n);
+    for (auto _ : state) {
+        smart::Tree<int> copy(tree);
+        benchmark::DoNotOptimize(copy.size());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(shapes::treeShapeName(shape));
+}
+
+void BM_SmartTreeMove(benchmark::State& state) {
+    const int64_t shape = state.range(0);
+    const size_t n = static_cast<size_t>(state.range(1));
+    const smart::Tree<int> tree = shapes::makeTree<smart::Tree<int>>(shape, n);
+    for (auto _ : state) {
+        // Only the move constructor is timed: building the source and freeing both trees
+        // would otherwise dominate the measurement.
+        smart::Tree<int> source(tree);
+        const auto start = std::chrono::steady_clock::now();
+        smart::Tree<int> moved(std::move(source));
+        benchmark::DoNotOptimize(moved.size());
+        const auto stop = std::chrono::steady_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(shapes::treeShapeName(shape));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_AddChild, lightweight::Tree<int>)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AddChild, lightweight::StableTree<int>)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AddChild, smart::Tree<int>)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Traversal, lightweight::Tree<int>, PreOrder)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, lightweight::Tree<int>, PostOrder)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, lightweight::Tree<int>, Bfs)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, lightweight::Tree<int>, ReversePreOrder)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, lightweight::Tree<int>, ReverseBfs)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, smart::Tree<int>, PreOrder)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, smart::Tree<int>, PostOrder)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Traversal, smart::Tree<int>, Bfs)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_SmartTreeCopy)->Apply(shapes::TreeShapesAndSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SmartTreeMove)->Apply(shapes::TreeShapesAndSizes)->UseManualTime()->Unit(benchmark::kMillisecond);
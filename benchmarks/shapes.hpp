@@ -0,0 +1,163 @@
+#ifndef BENCHMARK_SHAPES_HPP
+#define BENCHMARK_SHAPES_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Seeded generators for the tree and graph shapes used by the benchmarks.
+ *
+ * Every generator is deterministic for a given size and seed, so runs of different
+ * revisions measure the same structures.
+ */
+namespace shapes {
+
+const uint64_t SEED = 42;
+
+enum TreeShape : int64_t {
+    DeepChain,       ///< Every node is the only child of the previous one.
+    Star,            ///< Every node is a child of the root.
+    RandomRecursive, ///< Every node picks a uniformly random earlier node as parent.
+    BalancedKary     ///< Complete 4-ary tree filled level by level.
+};
+
+enum GraphShape : int64_t {
+    Uniform,       ///< Random endpoints, average out-degree 8.
+    Grid,          ///< Square 2D lattice with right and down edges.
+    PowerLaw       ///< Preferential attachment, 4 edges per new node.
+};
+
+inline const char* treeShapeName(int64_t shape) {
+    static const char* names[] = { "deep_chain", "star", "random_recursive", "balanced_4ary" };
+    return names[shape];
+}
+
+inline const char* graphShapeName(int64_t shape) {
+    static const char* names[] = { "uniform", "grid", "power_law" };
+    return names[shape];
+}
+
+/**
+ * @brief Returns the parent of every node but the root (entry 0 is unused).
+ */
+inline std::vector<size_t> treeParents(int64_t shape, size_t n, uint64_t seed = SEED) {
+    std::vector<size_t> parents(n, 0);
+    std::mt19937_64 rng(seed);
+    for (size_t i = 1; i < n; ++i) {
+        switch (shape) {
+        case DeepChain: parents[i] = i - 1; break;
+        case Star: parents[i] = 0; break;
+        case RandomRecursive: parents[i] = static_cast<size_t>(rng() % i); break;
+        default: parents[i] = (i - 1) / 4; break;
+        }
+    }
+    return parents;
+}
+
+/**
+ * @brief Builds a tree of a given shape through `addChild`.
+ *
+ * @tparam TreeType A tree with an `(root value, capacity)` constructor and `addChild(parent, value)`.
+ * @param reserve Whether storage for all nodes is reserved up front.
+ */
+template <typename TreeType>
+TreeType makeTree(int64_t shape, size_t n, bool reserve = true, uint64_t seed = SEED) {
+    const std::vector<size_t> parents = treeParents(shape, n, seed);
+    TreeType tree(0, reserve ? n : 16);
+    for (size_t i = 1; i < n; ++i) {
+        tree.addChild(parents[i], static_cast<int>(i));
+    }
+    return tree;
+}
+
+/**
+ * @brief Returns the edges of a graph of a given shape with `n` nodes.
+ */
+inline std::vector<std::pair<size_t, size_t>> graphEdges(int64_t shape, size_t n, uint64_t seed = SEED) {
+    std::vector<std::pair<size_t, size_t>> edges;
+    std::mt19937_64 rng(seed);
+    if (shape == Uniform) {
+        edges.reserve(8 * n);
+        for (size_t i = 0; i < 8 * n; ++i) {
+            edges.emplace_back(static_cast<size_t>(rng() % n), static_cast<size_t>(rng() % n));
+        }
+    } else if (shape == Grid) {
+        size_t side = 1;
+        while (side * side < n) {
+            ++side;
+        }
+        edges.reserve(2 * n);
+        for (size_t i = 0; i < n; ++i) {
+            if ((i + 1) % side != 0 && i + 1 < n) {
+                edges.emplace_back(i, i + 1);
+            }
+            if (i + side < n) {
+                edges.emplace_back(i, i + side);
+            }
+        }
+    } else {
+        // Picking a random endpoint of a random earlier edge is picking a node by degree.
+        edges.reserve(4 * n);
+        for (size_t i = 1; i < n; ++i) {
+            for (size_t k = 0; k < 4; ++k) {
+                size_t target;
+                if (edges.empty() || rng() % 2 == 0) {
+                    target = static_cast<size_t>(rng() % i);
+                } else {
+                    const auto& edge = edges[rng() % edges.size()];
+                    target = rng() % 2 == 0 ? edge.first : edge.second;
+                }
+                edges.emplace_back(i, target);
+            }
+        }
+    }
+    return edges;
+}
+
+/**
+ * @brief Builds a graph or digraph of a given shape through `emplace_node` and `addEdge`.
+ */
+template <typename GraphType>
+GraphType makeGraph(int64_t shape, size_t n, uint64_t seed = SEED) {
+    const auto edges = graphEdges(shape, n, seed);
+    GraphType graph;
+    graph.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        graph.emplace_node(static_cast<int>(i));
+    }
+    for (const auto& edge : edges) {
+        graph.addEdge(edge.first, edge.second);
+    }
+    return graph;
+}
+
+/**
+ * @brief Registers every tree shape with sizes 1e3, 1e4, ..., 1e7.
+ */
+inline void TreeShapesAndSizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({ "shape", "nodes" });
+    for (int64_t shape = DeepChain; shape <= BalancedKary; ++shape) {
+        for (int64_t n = 1000; n <= 10000000; n *= 10) {
+            bench->Args({ shape, n });
+        }
+    }
+}
+
+/**
+ * @brief Registers every graph shape with sizes 1e3, 1e4, ..., 1e7.
+ */
+inline void GraphShapesAndSizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({ "shape", "nodes" });
+    for (int64_t shape = Uniform; shape <= PowerLaw; ++shape) {
+        for (int64_t n = 1000; n <= 10000000; n *= 10) {
+            bench->Args({ shape, n });
+        }
+    }
+}
+
+} // namespace shapes
+
+#endif // BENCHMARK_SHAPES_HPP
@@ -0,0 +1,311 @@
+#ifndef COMPRESSED_DIGRAPH_HPP
+#define COMPRESSED_DIGRAPH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vpr {
+namespace lightweight {
+namespace detail {
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t getVarint(const uint8_t*& p) {
+    uint8_t byte = *p++;
+    if (byte < 0x80) {
+        return byte;
+    }
+    uint64_t value = byte & 0x7F;
+    unsigned shift = 7;
+    do {
+        byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace detail
+
+/**
+ * @brief An immutable directed graph storing its adjacency as delta-encoded varints.
+ *
+ * Every out-edge list is sorted and stored in a single byte array as its degree, the
+ * zigzag-encoded difference between the first target and the source, then the gaps
+ * between consecutive targets, all as LEB128 varints. An offsets index gives the start of
+ * every list. Graphs with locality (see `reorder`) typically need one or two bytes per
+ * edge instead of eight.
+ *
+ * Lists are decoded on the fly while iterating `getNode(i).edges()`, so the graph works with
+ * the traversal algorithms taking any graph type, such as `algorithms::bfsDistances`.
+ *
+ * @tparam T The type of the value stored in each node.
+ */
+template <typename T>
+class CompressedDigraph {
+public:
+
+    /**
+     * @brief Forward iterator decoding the targets of an edge list.
+     */
+    class EdgeIterator {
+
+        const uint8_t* p_;  ///< Next byte to decode.
+        size_t remaining_;  ///< Number of targets left, including the current one.
+        size_t current_;    ///< Current target.
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = const size_t&;
+
+        EdgeIterator() : p_(nullptr), remaining_(0), current_(0) {}
+
+        EdgeIterator(const uint8_t* p, size_t degree, size_t source)
+            : p_(p), remaining_(degree), current_(0) {
+            if (remaining_ != 0) {
+                current_ = static_cast<size_t>(static_cast<int64_t>(source) + detail::unzigzag(detail::getVarint(p_)));
+            }
+        }
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+
+        EdgeIterator& operator++() {
+            if (--remaining_ != 0) {
+                current_ += static_cast<size_t>(detail::getVarint(p_));
+            }
+            return *this;
+        }
+
+        EdgeIterator operator++(int) {
+            EdgeIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const EdgeIterator& other) const { return remaining_ == other.remaining_; }
+        bool operator!=(const EdgeIterator& other) const { return remaining_ != other.remaining_; }
+    };
+
+    /**
+     * @brief Range over the sorted targets of a node.
+     */
+    class EdgeRange {
+
+        const uint8_t* data_; ///< First byte after the degree.
+        size_t degree_;       ///< Number of targets.
+        size_t source_;       ///< Index of the node owning the list.
+
+    public:
+        using value_type = size_t;
+        using const_iterator = EdgeIterator;
+
+        EdgeRange(const uint8_t* data, size_t degree, size_t source)
+            : data_(data), degree_(degree), source_(source) {}
+
+        EdgeIterator begin() const { return EdgeIterator(data_, degree_, source_); }
+        EdgeIterator end() const { return EdgeIterator(); }
+        size_t size() const noexcept { return degree_; }
+        bool empty() const noexcept { return degree_ == 0; }
+    };
+
+    /**
+     * @brief Read-only view of a node, returned by value.
+     */
+    class Node {
+
+        const CompressedDigraph* graph_; ///< Owning graph.
+        size_t index_;                   ///< Index of the node.
+
+    public:
+        using DataType = T;
+
+        Node(const CompressedDigraph* graph, size_t index) : graph_(graph), index_(index) {}
+
+        size_t index() const noexcept { return index_; }
+        const T& value() const { return graph_->values_[index_]; }
+        const T& operator*() const { return value(); }
+        const T* operator->() const { return &value(); }
+        EdgeRange edges() const { return graph_->edgeRange(index_); }
+        size_t degree() const { return edges().size(); }
+        bool isolated() const { return degree() == 0; }
+    };
+
+private:
+
+    std::vector<T> values_;         ///< Node values.
+    std::vector<uint64_t> offsets_; ///< Start of every edge list in `bytes_`, plus the end.
+    std::vector<uint8_t> bytes_;    ///< Encoded edge lists.
+    size_t edgeCount_ = 0;          ///< Total number of edges.
+
+public:
+
+    /**
+     * @brief Compresses a graph or digraph, keeping its node indices.
+     *
+     * @tparam GraphType The type of the source graph, e.g. `lightweight::Digraph`.
+     * @param graph The graph to compress. It must not contain removed nodes.
+     * @throw std::invalid_argument If the graph contains removed nodes.
+     */
+    template <typename GraphType>
+    explicit CompressedDigraph(const GraphType& graph) {
+        const size_t n = graph.size();
+        values_.reserve(n);
+        offsets_.reserve(n + 1);
+        std::vector<size_t> targets;
+        for (size_t i = 0; i < n; ++i) {
+            if (graph.isRemoved(i)) {
+                throw std::invalid_argument("Cannot compress a graph with removed nodes, compact it first.");
+            }
+            const auto& edges = graph.getNode(i).edges();
+            targets.assign(edges.begin(), edges.end());
+            values_.push_back(graph.getNode(i).value());
+            appendList(i, targets);
+        }
+        offsets_.push_back(bytes_.size());
+        bytes_.shrink_to_fit();
+    }
+
+    /**
+     * @brief Compresses a CSR adjacency, without building an uncompressed graph first.
+     *
+     * @tparam Index Integer type of the CSR arrays.
+     * @param values One value per node.
+     * @param offsets `values.size() + 1` non-decreasing offsets into `targets`, starting at 0.
+     * @param targets The target indices.
+     * @throw std::invalid_argument If the offsets are inconsistent.
+     * @throw std::out_of_range If a target index is invalid.
+     */
+    template <typename Index>
+    CompressedDigraph(std::vector<T> values, const std::vector<Index>& offsets, const std::vector<Index>& targets)
+        : values_(std::move(values)) {
+        const size_t n = values_.size();
+        if (offsets.size() != n + 1 || offsets[0] != 0 || static_cast<size_t>(offsets[n]) != targets.size()) {
+            throw std::invalid_argument("Invalid adjacency offsets.");
+        }
+        offsets_.reserve(n + 1);
+        std::vector<size_t> list;
+        for (size_t i = 0; i < n; ++i) {
+            if (offsets[i] > offsets[i + 1]) {
+                throw std::invalid_argument("Invalid adjacency offsets.");
+            }
+            list.assign(targets.begin() + offsets[i], targets.begin() + offsets[i + 1]);
+            for (size_t target : list) {
+                if (target >= n) {
+                    throw std::out_of_range("Invalid node index.");
+                }
+            }
+            appendList(i, list);
+        }
+        offsets_.push_back(bytes_.size());
+        bytes_.shrink_to_fit();
+    }
+
+    inline size_t size() const noexcept { return values_.size(); }
+    inline bool empty() const noexcept { return values_.empty(); }
+    inline size_t edgeCount() const noexcept { return edgeCount_; }
+
+    /**
+     * @brief Compressed graphs have sorted edge lists.
+     */
+    inline bool isNormalized() const noexcept { return true; }
+
+    /**
+     * @brief Compressed graphs never contain removed nodes.
+     */
+    inline bool isRemoved(size_t) const noexcept { return false; }
+
+    /**
+     * @brief Returns a view of a node.
+     *
+     * @param index The index of the node.
+     * @return The node view, valid as long as the graph.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    Node getNode(size_t index) const {
+        validateIndex(index);
+        return Node(this, index);
+    }
+
+    /**
+     * @brief Checks whether an edge exists, decoding the source's list up to the target.
+     *
+     * @param from The index of the source node.
+     * @param to The index of the target node.
+     * @return `true` if the edge exists, otherwise `false`.
+     * @throw std::out_of_range If either index is invalid.
+     */
+    bool hasEdge(size_t from, size_t to) const {
+        validateIndex(from);
+        validateIndex(to);
+        for (size_t target : edgeRange(from)) {
+            if (target >= to) {
+                return target == to;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Returns the number of bytes used by the encoded adjacency and its index.
+     */
+    size_t adjacencyBytes() const noexcept {
+        return bytes_.capacity() + offsets_.capacity() * sizeof(uint64_t);
+    }
+
+private:
+
+    void validateIndex(size_t index) const {
+        if (index >= values_.size()) {
+            throw std::out_of_range("Invalid node index.");
+        }
+    }
+
+    void appendList(size_t source, std::vector<size_t>& targets) {
+        std::sort(targets.begin(), targets.end());
+        offsets_.push_back(bytes_.size());
+        detail::putVarint(bytes_, targets.size());
+        size_t previous = 0;
+        for (size_t k = 0; k < targets.size(); ++k) {
+            if (k == 0) {
+                detail::putVarint(bytes_, detail::zigzag(static_cast<int64_t>(targets[0]) - static_cast<int64_t>(source)));
+            } else {
+                detail::putVarint(bytes_, targets[k] - previous);
+            }
+            previous = targets[k];
+        }
+        edgeCount_ += targets.size();
+    }
+
+    EdgeRange edgeRange(size_t index) const {
+        const uint8_t* p = bytes_.data() + offsets_[index];
+        const size_t degree = static_cast<size_t>(detail::getVarint(p));
+        return EdgeRange(p, degree, index);
+    }
+};
+
+} // namespace lightweight
+} // namespace vpr
+
+#endif // COMPRESSED_DIGRAPH_HPP
@@ -3,6 +3,7 @@
 
 #include "graph_template.hpp"
 #include "node_template.hpp"
+#include "reorder.hpp"
 
 namespace vpr {
 namespace lightweight {
@@ -50,11 +51,77 @@ public:
      * 
      * @param from The index of the source node.
      * @param to The index of the target node.
+     * @throw std::out_of_range If either index is invalid.
+     * @throw std::invalid_argument If either node is removed.
      */
     void addEdge(size_t from, size_t to) {
         Base::addEdge(from, to);
     }
 
+    /**
+     * @brief Removes a directed edge between two nodes.
+     * 
+     * Removes one occurrence of the edge from `from` to `to`. Runs in O(out-degree of `from`).
+     * 
+     * @param from The index of the source node.
+     * @param to The index of the target node.
+     * @return `true` if the edge existed, otherwise `false`.
+     * @throw std::out_of_range If `from` is invalid.
+     */
+    bool removeEdge(size_t from, size_t to) {
+        return Base::removeEdge(from, to);
+    }
+
+    /**
+     * @brief Removes a node and its outgoing edges.
+     * 
+     * The node becomes a tombstone: it is skipped by the node iterators, `hasEdge` no longer
+     * reports edges to it, and its slot is reclaimed by `compact()`. Since a digraph does not
+     * track incoming edges, those are pruned lazily by `compact()`, keeping this O(out-degree).
+     * 
+     * Until then `getNode(i).edges()` may still list the removed node: code reading edges
+     * directly must skip targets for which `isRemoved()` is true, as the library algorithms
+     * (`bfsDistances`, `reorder`, `runDag`) and the exporters do.
+     * 
+     * @param index The index of the node to remove.
+     * @return `true` if the node was removed, `false` if it already was.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    bool removeNode(size_t index) {
+        return Base::markRemoved(index);
+    }
+
+    /**
+     * @brief Replaces all the edges of the digraph with a CSR adjacency, for bulk loading.
+     * 
+     * The out-edges of node `i` are `targets[offsets[i]]` to `targets[offsets[i + 1] - 1]`.
+     * 
+     * @tparam Index Integer type of the CSR arrays.
+     * @param offsets `size() + 1` non-decreasing offsets into `targets`, starting at 0.
+     * @param targets The target indices.
+     * @throw std::invalid_argument If the offsets are inconsistent.
+     * @throw std::out_of_range If a target index is invalid.
+     */
+    template <typename Index>
+    void assignAdjacency(const std::vector<Index>& offsets, const std::vector<Index>& targets) {
+        Base::assignAdjacency(offsets, targets);
+    }
+
+    /**
+     * @brief Renumbers the nodes to improve memory locality.
+     * 
+     * Node storage is permuted and every edge index is rewritten, so that nodes visited
+     * together end up close in memory. Meant to be run once after loading the digraph.
+     * 
+     * @param strategy The ordering strategy.
+     * @return A permutation mapping every old node index to its new index.
+     */
+    std::vector<size_t> reorder(algorithms::ReorderStrategy strategy) {
+        std::vector<size_t> permutation = algorithms::computeOrdering(*this, strategy);
+        Base::permute(permutation);
+        return permutation;
+    }
+
 };
 
 } // namespace lightweight
@@ -0,0 +1,159 @@
+#ifndef BFS_HPP
+#define BFS_HPP
+
+#include "atomic_bitmap.hpp"
+#include "work_stealing.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Distance reported for nodes that cannot be reached from the source.
+ */
+constexpr size_t UNREACHABLE = static_cast<size_t>(-1);
+
+/**
+ * @brief Computes the hop distance from a source node to every node of a graph.
+ *
+ * Performs a level-synchronous breadth-first search following the outgoing edges of each
+ * node. Edges to removed nodes, which a digraph keeps until `compact()`, are ignored and
+ * removed nodes are reported as `UNREACHABLE`. Works with any graph exposing `size()`,
+ * `isRemoved(i)` and `getNode(i).edges()`, such as `lightweight::Graph` and `lightweight::Digraph`.
+ *
+ * @tparam GraphType The type of the graph.
+ * @param graph The graph to traverse.
+ * @param source Index of the node the search starts from.
+ * @return A vector with one distance per node, `UNREACHABLE` for nodes not reached.
+ * @throw std::out_of_range If `source` is not a valid node index.
+ */
+template <typename GraphType>
+std::vector<size_t> bfsDistances(const GraphType& graph, size_t source) {
+    if (source >= graph.size()) {
+        throw std::out_of_range("Invalid node index.");
+    }
+
+    std::vector<size_t> distance(graph.size(), UNREACHABLE);
+    std::vector<size_t> frontier(1, source);
+    std::vector<size_t> next;
+    distance[source] = 0;
+
+    for (size_t level = 1; !frontier.empty(); ++level) {
+        next.clear();
+        for (size_t u : frontier) {
+            for (size_t v : graph.getNode(u).edges()) {
+                if (distance[v] == UNREACHABLE && !graph.isRemoved(v)) {
+                    distance[v] = level;
+                    next.push_back(v);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return distance;
+}
+
+/**
+ * @brief Multi-threaded version of `bfsDistances`.
+ *
+ * The frontier of each level is split into chunks of `grain` nodes which are consumed by a
+ * team of work-stealing workers. Nodes are claimed through an atomic bitmap, so every node is
+ * discovered by exactly one worker, and workers collect the next frontier in private buffers
+ * that are concatenated in parallel between levels. The distance of a node is the level at
+ * which it is first discovered, therefore the result is identical to `bfsDistances` no matter
+ * how the work is interleaved.
+ *
+ * @tparam GraphType The type of the graph.
+ * @param graph The graph to traverse. It must not be modified during the search.
+ * @param source Index of the node the search starts from.
+ * @param nThreads Number of worker threads, including the calling thread.
+ * @param grain Number of frontier nodes handed to a worker at a time.
+ * @return A vector with one distance per node, `UNREACHABLE` for nodes not reached.
+ * @throw std::out_of_range If `source` is not a valid node index.
+ */
+template <typename GraphType>
+std::vector<size_t> parallelBfsDistances(const GraphType& graph, size_t source,
+                                         size_t nThreads = parallel::hardwareConcurrency(),
+                                         size_t grain = 256) {
+    if (nThreads <= 1) {
+        return bfsDistances(graph, source);
+    }
+    if (source >= graph.size()) {
+        throw std::out_of_range("Invalid node index.");
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    std::vector<size_t> distance(graph.size(), UNREACHABLE);
+    parallel::AtomicBitmap visited(graph.size());
+    visited.claim(source);
+    distance[source] = 0;
+
+    std::vector<size_t> frontiers[2] = { std::vector<size_t>(1, source), std::vector<size_t>() };
+    std::vector<std::vector<size_t>> discovered(nThreads);
+    std::vector<size_t> offsets(nThreads);
+
+    parallel::ChunkScheduler scheduler(nThreads);
+    parallel::SpinBarrier barrier(nThreads);
+    scheduler.reset(1);
+    size_t level = 0;
+
+    parallel::runTeam(nThreads, [&](size_t worker) {
+        std::vector<size_t>& local = discovered[worker];
+
+        while (true) {
+            const std::vector<size_t>& frontier = frontiers[level & 1];
+            const size_t nextLevel = level + 1;
+
+            // Expand the current frontier.
+            size_t chunk;
+            while (scheduler.next(worker, chunk)) {
+                const size_t begin = chunk * grain;
+                const size_t end = std::min(begin + grain, frontier.size());
+                for (size_t i = begin; i < end; ++i) {
+                    for (size_t v : graph.getNode(frontier[i]).edges()) {
+                        if (!graph.isRemoved(v) && visited.claim(v)) {
+                            distance[v] = nextLevel;
+                            local.push_back(v);
+                        }
+                    }
+                }
+            }
+            barrier.wait();
+
+            // Size the next frontier and schedule it.
+            if (worker == 0) {
+                size_t total = 0;
+                for (size_t w = 0; w < nThreads; ++w) {
+                    offsets[w] = total;
+                    total += discovered[w].size();
+                }
+                frontiers[nextLevel & 1].resize(total);
+                scheduler.reset((total + grain - 1) / grain);
+                level = nextLevel;
+            }
+            barrier.wait();
+
+            // Concatenate the private buffers into the next frontier.
+            std::vector<size_t>& next = frontiers[nextLevel & 1];
+            std::copy(local.begin(), local.end(), next.begin() + offsets[worker]);
+            local.clear();
+            barrier.wait();
+
+            if (next.empty()) {
+                break;
+            }
+        }
+    });
+
+    return distance;
+}
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // BFS_HPP
@@ -0,0 +1,308 @@
+#ifndef DAG_EXECUTOR_HPP
+#define DAG_EXECUTOR_HPP
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Outcome of a task run by `runDag`.
+ */
+enum class TaskState : uint8_t {
+    Succeeded, ///< The task returned normally.
+    Failed,    ///< The task threw an exception.
+    Cancelled, ///< The task did not run because a predecessor failed or was cancelled.
+    Skipped    ///< The node is removed from the graph and is not a task.
+};
+
+/**
+ * @brief Options of `runDag`.
+ */
+struct DagOptions {
+    bool cancelAllOnFailure = false; ///< Also cancel independent tasks not started yet after a failure.
+};
+
+/**
+ * @brief Result of `runDag`.
+ */
+struct DagReport {
+    std::vector<TaskState> states;    ///< Outcome of every node.
+    std::vector<double> seconds;      ///< Run time of every task, 0 for tasks that did not run.
+    std::vector<size_t> criticalPath; ///< Chain of dependent tasks with the largest total run time, in execution order.
+    double criticalPathSeconds = 0;   ///< Total run time of the critical path.
+    double wallSeconds = 0;           ///< Elapsed time of the whole run.
+    size_t failed = 0;                ///< Number of failed tasks.
+    size_t cancelled = 0;             ///< Number of cancelled tasks.
+    std::exception_ptr firstError;    ///< Exception of the first task that failed.
+
+    inline bool succeeded() const noexcept { return failed == 0 && cancelled == 0; }
+
+    /**
+     * @brief Rethrows the exception of the first failed task, if any.
+     */
+    void rethrowIfFailed() const {
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Ready queue of a worker: the owner works at the back, thieves take the front.
+ */
+class TaskDeque {
+
+    std::mutex mutex_;        ///< Protects the queue.
+    std::deque<size_t> tasks_; ///< Ready tasks.
+
+public:
+    void push(size_t task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+    }
+
+    bool pop(size_t& task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = tasks_.back();
+        tasks_.pop_back();
+        return true;
+    }
+
+    bool steal(size_t& task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = tasks_.front();
+        tasks_.pop_front();
+        return true;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Runs every node of a DAG as a task, each one as soon as all its predecessors are done.
+ *
+ * An edge `u -> v` means that `v` depends on `u`. Every node holds an atomic counter of
+ * unfinished predecessors; the worker finishing the last one pushes the node on its own
+ * ready queue, and idle workers steal from the other queues. A task that throws is marked
+ * failed and every task depending on it, directly or not, is cancelled without running;
+ * independent tasks keep running unless `options.cancelAllOnFailure` is set. Removed nodes
+ * are skipped. A worker that finds no ready task after a few rounds of stealing sleeps until
+ * a task is pushed or the run ends, so long tasks do not keep idle workers spinning.
+ *
+ * Once every task is done the critical path, the chain of dependent tasks with the largest
+ * total measured run time, is reported. Works with any directed graph exposing `size()`,
+ * `isRemoved(i)` and `getNode(i).edges()`, such as `lightweight::Digraph`.
+ *
+ * @tparam Executor An executor such as `parallel::ThreadPool`.
+ * @tparam GraphType The type of the graph.
+ * @tparam TaskFn Callable `void(const GraphType::Node&)`, called once per task.
+ * @param executor The executor running the workers.
+ * @param dag The dependency graph.
+ * @param task Function running the task of a node.
+ * @param options Failure handling options.
+ * @return The outcome and timing of every task.
+ * @throw std::invalid_argument If the graph contains a cycle.
+ */
+template <typename Executor, typename GraphType, typename TaskFn,
+          typename = typename std::enable_if<parallel::IsExecutor<Executor>::value>::type>
+DagReport runDag(Executor& executor, const GraphType& dag, TaskFn task, const DagOptions& options = DagOptions()) {
+    using Clock = std::chrono::steady_clock;
+    const size_t n = dag.size();
+    const size_t NONE = static_cast<size_t>(-1);
+
+    // Kahn's algorithm rejects cycles up front and gives the order used for the critical path.
+    std::vector<size_t> predecessors(n, 0);
+    for (size_t u = 0; u < n; ++u) {
+        if (dag.isRemoved(u)) {
+            continue;
+        }
+        for (size_t v : dag.getNode(u).edges()) {
+            if (!dag.isRemoved(v)) {
+                ++predecessors[v];
+            }
+        }
+    }
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<size_t> remainingPredecessors(predecessors);
+    for (size_t u = 0; u < n; ++u) {
+        if (!dag.isRemoved(u) && predecessors[u] == 0) {
+            order.push_back(u);
+        }
+    }
+    const size_t nSources = order.size();
+    for (size_t k = 0; k < order.size(); ++k) {
+        for (size_t v : dag.getNode(order[k]).edges()) {
+            if (!dag.isRemoved(v) && --remainingPredecessors[v] == 0) {
+                order.push_back(v);
+            }
+        }
+    }
+    size_t nTasks = 0;
+    for (size_t u = 0; u < n; ++u) {
+        nTasks += dag.isRemoved(u) ? 0 : 1;
+    }
+    if (order.size() != nTasks) {
+        throw std::invalid_argument("Task graph contains a cycle.");
+    }
+
+    DagReport report;
+    report.states.assign(n, TaskState::Skipped);
+    report.seconds.assign(n, 0.0);
+    std::unique_ptr<std::atomic<size_t>[]> pending(new std::atomic<size_t>[n]);
+    std::unique_ptr<std::atomic<bool>[]> poisoned(new std::atomic<bool>[n]);
+    for (size_t u = 0; u < n; ++u) {
+        pending[u].store(predecessors[u], std::memory_order_relaxed);
+        poisoned[u].store(false, std::memory_order_relaxed);
+    }
+
+    const size_t nWorkers = std::max<size_t>(1, std::min(executor.size(), nTasks));
+    std::unique_ptr<detail::TaskDeque[]> queues(new detail::TaskDeque[nWorkers]);
+    for (size_t k = 0; k < nSources; ++k) {
+        queues[k % nWorkers].push(order[k]);
+    }
+    std::atomic<size_t> unfinished(nTasks);
+    std::atomic<bool> anyFailure(false);
+    std::mutex errorMutex;
+
+    // Idle workers park on `wakeup`. `ready` never undercounts the queued tasks, and both it
+    // and `sleepers` are sequentially consistent, so a pusher either sees a sleeper to notify
+    // or the sleeper sees the new task before waiting.
+    const size_t SPIN_ROUNDS = 64;
+    std::atomic<size_t> ready(nSources);
+    std::atomic<size_t> sleepers(0);
+    std::mutex parkMutex;
+    std::condition_variable wakeup;
+
+    const Clock::time_point started = Clock::now();
+    executor.run(nWorkers, [&](size_t worker) {
+        detail::TaskDeque& own = queues[worker];
+        size_t idleRounds = 0;
+        while (unfinished.load(std::memory_order_acquire) != 0) {
+            size_t u;
+            bool found = own.pop(u);
+            for (size_t k = 1; !found && k < nWorkers; ++k) {
+                found = queues[(worker + k) % nWorkers].steal(u);
+            }
+            if (!found) {
+                if (++idleRounds < SPIN_ROUNDS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(parkMutex);
+                sleepers.fetch_add(1);
+                wakeup.wait(lock, [&] { return ready.load() != 0 || unfinished.load() == 0; });
+                sleepers.fetch_sub(1);
+                idleRounds = 0;
+                continue;
+            }
+            ready.fetch_sub(1);
+            idleRounds = 0;
+
+            bool ok = false;
+            if (poisoned[u].load(std::memory_order_acquire) ||
+                (options.cancelAllOnFailure && anyFailure.load(std::memory_order_acquire))) {
+                report.states[u] = TaskState::Cancelled;
+            } else {
+                const Clock::time_point begin = Clock::now();
+                try {
+                    task(dag.getNode(u));
+                    report.states[u] = TaskState::Succeeded;
+                    ok = true;
+                } catch (...) {
+                    report.states[u] = TaskState::Failed;
+                    anyFailure.store(true, std::memory_order_release);
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!report.firstError) {
+                        report.firstError = std::current_exception();
+                    }
+                }
+                report.seconds[u] = std::chrono::duration<double>(Clock::now() - begin).count();
+            }
+
+            for (size_t v : dag.getNode(u).edges()) {
+                if (dag.isRemoved(v)) {
+                    continue;
+                }
+                if (!ok) {
+                    poisoned[v].store(true, std::memory_order_release);
+                }
+                if (pending[v].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    ready.fetch_add(1);
+                    own.push(v);
+                    if (sleepers.load() != 0) {
+                        std::lock_guard<std::mutex> lock(parkMutex);
+                        wakeup.notify_one();
+                    }
+                }
+            }
+            if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(parkMutex);
+                wakeup.notify_all();
+            }
+        }
+    });
+    report.wallSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    // Longest path by run time, relaxing the edges in topological order.
+    std::vector<double> finish(n, 0.0);
+    std::vector<size_t> via(n, NONE);
+    size_t last = NONE;
+    for (size_t u : order) {
+        finish[u] += report.seconds[u];
+        if (last == NONE || finish[u] > finish[last]) {
+            last = u;
+        }
+        for (size_t v : dag.getNode(u).edges()) {
+            if (!dag.isRemoved(v) && (via[v] == NONE || finish[u] > finish[v])) {
+                finish[v] = finish[u];
+                via[v] = u;
+            }
+        }
+        report.failed += report.states[u] == TaskState::Failed ? 1 : 0;
+        report.cancelled += report.states[u] == TaskState::Cancelled ? 1 : 0;
+    }
+    if (last != NONE) {
+        report.criticalPathSeconds = finish[last];
+        for (size_t u = last; u != NONE; u = via[u]) {
+            report.criticalPath.push_back(u);
+        }
+        std::reverse(report.criticalPath.begin(), report.criticalPath.end());
+    }
+    return report;
+}
+
+/**
+ * @brief Runs a DAG of tasks on `parallel::defaultPool()`, see `runDag(executor, dag, task, options)`.
+ */
+template <typename GraphType, typename TaskFn>
+DagReport runDag(const GraphType& dag, TaskFn task, const DagOptions& options = DagOptions()) {
+    return runDag(parallel::defaultPool(), dag, task, options);
+}
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // DAG_EXECUTOR_HPP
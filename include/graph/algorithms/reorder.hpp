@@ -0,0 +1,114 @@
+#ifndef REORDER_HPP
+#define REORDER_HPP
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Node ordering strategies used to improve memory locality.
+ */
+enum class ReorderStrategy {
+    ReverseCuthillMcKee, ///< Bandwidth-reducing BFS from low-degree nodes, visited in degree order, then reversed.
+    DegreeDescending,    ///< Hubs first, ties keep their original order.
+    BreadthFirst         ///< Nodes numbered in the order a BFS discovers them, one component at a time.
+};
+
+namespace detail {
+
+/**
+ * @brief Appends to `order` the nodes reached by a BFS from `start`.
+ *
+ * When `byDegree` is set, the unvisited neighbours of every node are enqueued by increasing
+ * degree (Cuthill–McKee); otherwise they are enqueued in edge order.
+ */
+template <typename GraphType>
+void appendBfsOrder(const GraphType& graph, size_t start, bool byDegree,
+                    std::vector<char>& visited, std::vector<size_t>& order) {
+    size_t head = order.size();
+    visited[start] = 1;
+    order.push_back(start);
+
+    std::vector<size_t> neighbours;
+    while (head < order.size()) {
+        size_t u = order[head++];
+        size_t first = order.size();
+        for (size_t v : graph.getNode(u).edges()) {
+            if (!visited[v] && !graph.isRemoved(v)) {
+                visited[v] = 1;
+                order.push_back(v);
+            }
+        }
+        if (byDegree) {
+            std::stable_sort(order.begin() + first, order.end(), [&graph](size_t a, size_t b) {
+                return graph.getNode(a).degree() < graph.getNode(b).degree();
+            });
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes a locality-improving permutation of the nodes of a graph.
+ *
+ * Removed nodes are placed after all the live nodes. For directed graphs the orderings
+ * follow outgoing edges.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @param graph The graph to reorder.
+ * @param strategy The ordering strategy.
+ * @return A permutation mapping every old node index to its new index.
+ */
+template <typename GraphType>
+std::vector<size_t> computeOrdering(const GraphType& graph, ReorderStrategy strategy) {
+    const size_t n = graph.size();
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<char> visited(n, 0);
+
+    std::vector<size_t> candidates(n);
+    std::iota(candidates.begin(), candidates.end(), size_t(0));
+    if (strategy != ReorderStrategy::BreadthFirst) {
+        const bool ascending = strategy == ReorderStrategy::ReverseCuthillMcKee;
+        std::stable_sort(candidates.begin(), candidates.end(), [&graph, ascending](size_t a, size_t b) {
+            size_t da = graph.getNode(a).degree();
+            size_t db = graph.getNode(b).degree();
+            return ascending ? da < db : da > db;
+        });
+    }
+
+    for (size_t u : candidates) {
+        if (visited[u] || graph.isRemoved(u)) {
+            continue;
+        }
+        if (strategy == ReorderStrategy::DegreeDescending) {
+            visited[u] = 1;
+            order.push_back(u);
+        } else {
+            detail::appendBfsOrder(graph, u, strategy == ReorderStrategy::ReverseCuthillMcKee, visited, order);
+        }
+    }
+    if (strategy == ReorderStrategy::ReverseCuthillMcKee) {
+        std::reverse(order.begin(), order.end());
+    }
+    for (size_t u = 0; u < n; ++u) {
+        if (graph.isRemoved(u)) {
+            order.push_back(u);
+        }
+    }
+
+    std::vector<size_t> permutation(n);
+    for (size_t i = 0; i < n; ++i) {
+        permutation[order[i]] = i;
+    }
+    return permutation;
+}
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // REORDER_HPP
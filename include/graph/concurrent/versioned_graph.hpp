@@ -0,0 +1,450 @@
+#ifndef VERSIONED_GRAPH_HPP
+#define VERSIONED_GRAPH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "epoch.hpp"
+#include "segmented_vector.hpp"
+
+namespace vpr {
+namespace concurrent {
+namespace detail {
+
+/**
+ * @brief An adjacency entry tagged with the order in which the edge was added.
+ */
+struct VersionedEdge {
+    size_t target;   ///< Index of the target node.
+    size_t sequence; ///< Number of edges added before this one.
+};
+
+/**
+ * @brief A growable edge array. The writer appends in place while there is room and
+ * replaces the whole block, retiring the old one, when it is full.
+ */
+struct EdgeBlock {
+    size_t capacity;           ///< Number of entries allocated after the header.
+    std::atomic<size_t> count; ///< Number of entries written.
+
+    VersionedEdge* entries() noexcept { return reinterpret_cast<VersionedEdge*>(this + 1); }
+    const VersionedEdge* entries() const noexcept { return reinterpret_cast<const VersionedEdge*>(this + 1); }
+
+    static EdgeBlock* create(size_t capacity) {
+        void* memory = ::operator new(sizeof(EdgeBlock) + capacity * sizeof(VersionedEdge));
+        EdgeBlock* block = new (memory) EdgeBlock;
+        block->capacity = capacity;
+        block->count.store(0, std::memory_order_relaxed);
+        return block;
+    }
+
+    static void destroy(void* block) {
+        static_cast<EdgeBlock*>(block)->~EdgeBlock();
+        ::operator delete(block);
+    }
+};
+
+/**
+ * @brief Read-only view of a node's edges as of a snapshot.
+ */
+class EdgeRange {
+public:
+    /**
+     * @brief Random access iterator yielding the target indices.
+     */
+    class Iterator {
+
+        const VersionedEdge* edge_; ///< Current entry.
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = const size_t&;
+
+        explicit Iterator(const VersionedEdge* edge = nullptr) : edge_(edge) {}
+
+        reference operator*() const { return edge_->target; }
+        pointer operator->() const { return &edge_->target; }
+        reference operator[](difference_type n) const { return edge_[n].target; }
+
+        Iterator& operator++() { ++edge_; return *this; }
+        Iterator& operator--() { --edge_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++edge_; return tmp; }
+        Iterator operator--(int) { Iterator tmp = *this; --edge_; return tmp; }
+        Iterator& operator+=(difference_type n) { edge_ += n; return *this; }
+        Iterator& operator-=(difference_type n) { edge_ -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(edge_ + n); }
+        Iterator operator-(difference_type n) const { return Iterator(edge_ - n); }
+        difference_type operator-(const Iterator& other) const { return edge_ - other.edge_; }
+
+        bool operator==(const Iterator& other) const { return edge_ == other.edge_; }
+        bool operator!=(const Iterator& other) const { return edge_ != other.edge_; }
+        bool operator<(const Iterator& other) const { return edge_ < other.edge_; }
+    };
+
+    using value_type = size_t;
+    using const_iterator = Iterator;
+
+    EdgeRange() : begin_(nullptr), end_(nullptr) {}
+    EdgeRange(const VersionedEdge* begin, const VersionedEdge* end) : begin_(begin), end_(end) {}
+
+    Iterator begin() const { return Iterator(begin_); }
+    Iterator end() const { return Iterator(end_); }
+    size_t size() const noexcept { return static_cast<size_t>(end_ - begin_); }
+    bool empty() const noexcept { return begin_ == end_; }
+    const size_t& operator[](size_t i) const { return begin_[i].target; }
+
+private:
+    const VersionedEdge* begin_; ///< First entry.
+    const VersionedEdge* end_;   ///< One past the last entry visible in the snapshot.
+};
+
+/**
+ * @brief A consistent, read-only version of a versioned structure.
+ *
+ * Holding a snapshot pins an epoch, which keeps every edge block it may read alive. It is
+ * cheap to take (one compare-and-swap and two loads) and should be released promptly so
+ * that the writer can reclaim old blocks.
+ *
+ * @tparam Store The versioned structure.
+ * @tparam NodeView The node view returned by `getNode`.
+ */
+template <typename Store, typename NodeView>
+class Snapshot {
+
+    const Store* store_; ///< Structure being read, `nullptr` once moved from.
+    size_t slot_;        ///< Pinned epoch slot.
+    size_t nodes_;       ///< Number of nodes visible in this version.
+    size_t edges_;       ///< Number of edges visible in this version.
+
+public:
+    Snapshot(const Store* store, size_t slot, size_t nodes, size_t edges)
+        : store_(store), slot_(slot), nodes_(nodes), edges_(edges) {}
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    Snapshot(Snapshot&& other) noexcept
+        : store_(other.store_), slot_(other.slot_), nodes_(other.nodes_), edges_(other.edges_) {
+        other.store_ = nullptr;
+    }
+
+    Snapshot& operator=(Snapshot&& other) noexcept {
+        if (this != &other) {
+            release();
+            store_ = other.store_;
+            slot_ = other.slot_;
+            nodes_ = other.nodes_;
+            edges_ = other.edges_;
+            other.store_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~Snapshot() { release(); }
+
+    /**
+     * @brief Unpins the epoch. The snapshot must not be used afterwards.
+     */
+    void release() noexcept {
+        if (store_ != nullptr) {
+            store_->epochs_.unpin(slot_);
+            store_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief Returns the number of nodes in this version.
+     */
+    inline size_t size() const noexcept { return nodes_; }
+    inline bool empty() const noexcept { return nodes_ == 0; }
+
+    /**
+     * @brief Returns the number of edges added up to this version.
+     */
+    inline size_t edgeCount() const noexcept { return edges_; }
+
+    /**
+     * @brief Returns a view of a node as of this version.
+     *
+     * @param index The index of the node.
+     * @return The node view, valid as long as the snapshot.
+     * @throw std::out_of_range If the node is not part of this version.
+     */
+    NodeView getNode(size_t index) const {
+        if (index >= nodes_) {
+            throw std::out_of_range("Invalid node index.");
+        }
+        return NodeView(store_, index, edges_);
+    }
+};
+
+/**
+ * @brief Storage shared by the versioned graphs and tree: node values in address-stable
+ * segments and per-node edge blocks reclaimed through epochs.
+ *
+ * A single writer appends nodes and edges; they stay invisible to readers until `publish`.
+ * A snapshot records the published edge count, then the node count. Every edge of a version
+ * was added before its counts were published, so it only refers to nodes of that version.
+ *
+ * @tparam T The type of the value stored in each node.
+ */
+template <typename T>
+class VersionedStore {
+protected:
+
+    struct Record {
+        T value;                          ///< Value of the node, immutable once added.
+        std::atomic<EdgeBlock*> edges;    ///< Current edge block, `nullptr` without edges.
+
+        template <typename... Args>
+        explicit Record(Args&&... args) : value(std::forward<Args>(args)...), edges(nullptr) {}
+    };
+
+    templates::SegmentedVector<Record> nodes_;  ///< Nodes, including unpublished ones.
+    size_t edgeCount_ = 0;                       ///< Edges added, including unpublished ones.
+    std::atomic<size_t> publishedNodes_;         ///< Nodes visible to new snapshots.
+    std::atomic<size_t> publishedEdges_;         ///< Edges visible to new snapshots.
+    mutable parallel::EpochManager epochs_;      ///< Reader pins and retired edge blocks.
+
+    template <typename, typename>
+    friend class Snapshot;
+
+    explicit VersionedStore(size_t initialCapacity, size_t maxReaders)
+        : publishedNodes_(0), publishedEdges_(0), epochs_(maxReaders) {
+        nodes_.reserve(initialCapacity);
+    }
+
+    ~VersionedStore() {
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            EdgeBlock* block = nodes_[i].edges.load(std::memory_order_relaxed);
+            if (block != nullptr) {
+                EdgeBlock::destroy(block);
+            }
+        }
+    }
+
+    VersionedStore(const VersionedStore&) = delete;
+    VersionedStore& operator=(const VersionedStore&) = delete;
+
+    void validateIndex(size_t index) const {
+        if (index >= nodes_.size()) {
+            throw std::out_of_range("Invalid node index.");
+        }
+    }
+
+    template <typename... Args>
+    size_t appendNode(Args&&... args) {
+        nodes_.emplace_back(std::forward<Args>(args)...);
+        return nodes_.size() - 1;
+    }
+
+    /**
+     * @brief Appends an edge, moving the edge list to a block twice as large when it is full.
+     * Readers of older versions keep using the old block until they unpin.
+     */
+    void appendEdge(size_t from, size_t to) {
+        Record& record = nodes_[from];
+        EdgeBlock* block = record.edges.load(std::memory_order_relaxed);
+        const size_t count = block == nullptr ? 0 : block->count.load(std::memory_order_relaxed);
+        if (block == nullptr || count == block->capacity) {
+            EdgeBlock* grown = EdgeBlock::create(block == nullptr ? 4 : 2 * block->capacity);
+            if (block != nullptr) {
+                std::copy(block->entries(), block->entries() + count, grown->entries());
+            }
+            grown->count.store(count, std::memory_order_relaxed);
+            record.edges.store(grown, std::memory_order_release);
+            if (block != nullptr) {
+                epochs_.retire(block, &EdgeBlock::destroy);
+            }
+            block = grown;
+        }
+        block->entries()[count] = VersionedEdge{ to, edgeCount_++ };
+        block->count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the edges of a node added before the first `edges` edges were published.
+     */
+    EdgeRange edgesAt(size_t index, size_t edges) const {
+        const EdgeBlock* block = nodes_[index].edges.load(std::memory_order_acquire);
+        if (block == nullptr) {
+            return EdgeRange();
+        }
+        const VersionedEdge* begin = block->entries();
+        const VersionedEdge* end = begin + block->count.load(std::memory_order_acquire);
+        // Entries are in sequence order, so the unpublished ones form a suffix.
+        while (end != begin && (end - 1)->sequence >= edges) {
+            --end;
+        }
+        return EdgeRange(begin, end);
+    }
+
+    const T& valueAt(size_t index) const { return nodes_[index].value; }
+
+    template <typename SnapshotType>
+    SnapshotType takeSnapshot(const typename SnapshotType::StoreType* store) const {
+        const size_t slot = epochs_.pin();
+        // Nodes are published before edges, so loading the edge count first guarantees that
+        // every edge of the snapshot targets one of its nodes.
+        const size_t edges = publishedEdges_.load(std::memory_order_acquire);
+        const size_t nodes = publishedNodes_.load(std::memory_order_acquire);
+        return SnapshotType(store, slot, nodes, edges);
+    }
+
+public:
+
+    /**
+     * @brief Makes every node and edge added so far visible to new snapshots, then frees the
+     * edge blocks no reader uses anymore. Writer only.
+     */
+    void publish() {
+        publishedNodes_.store(nodes_.size(), std::memory_order_release);
+        publishedEdges_.store(edgeCount_, std::memory_order_release);
+        if (epochs_.pending() != 0) {
+            epochs_.collect();
+        }
+    }
+
+    /**
+     * @brief Returns the number of nodes added by the writer, including unpublished ones.
+     */
+    inline size_t size() const noexcept { return nodes_.size(); }
+
+    /**
+     * @brief Returns the number of edge entries added by the writer, including unpublished ones.
+     */
+    inline size_t edgeCount() const noexcept { return edgeCount_; }
+
+    /**
+     * @brief Returns the number of replaced edge blocks still waiting for readers to unpin.
+     */
+    inline size_t pendingReclamation() const noexcept { return epochs_.pending(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief A directed graph with snapshot isolation: readers traverse a consistent version
+ * while a single writer keeps adding nodes and edges.
+ *
+ * Changes become visible atomically at `publish()`. Readers call `snapshot()` from any
+ * thread and never take a lock; edge blocks replaced by the writer are reclaimed once the
+ * snapshots that may read them are released.
+ *
+ * @tparam T The type of the value stored in each node.
+ */
+template <typename T>
+class VersionedDigraph : public detail::VersionedStore<T> {
+    using Base = detail::VersionedStore<T>;
+
+public:
+
+    /**
+     * @brief Read-only view of a node as of a snapshot.
+     */
+    class Node {
+
+        const VersionedDigraph* graph_; ///< Owning graph.
+        size_t index_;                  ///< Index of the node.
+        size_t edges_;                  ///< Edge count of the snapshot.
+
+    public:
+        using DataType = T;
+
+        Node(const VersionedDigraph* graph, size_t index, size_t edges) : graph_(graph), index_(index), edges_(edges) {}
+
+        size_t index() const noexcept { return index_; }
+        const T& value() const { return graph_->valueAt(index_); }
+        const T& operator*() const { return value(); }
+        const T* operator->() const { return &value(); }
+        detail::EdgeRange edges() const { return graph_->edgesAt(index_, edges_); }
+        size_t degree() const { return edges().size(); }
+        bool isolated() const { return degree() == 0; }
+    };
+
+    /**
+     * @brief A consistent version of the graph, see `detail::Snapshot`.
+     */
+    class Snapshot : public detail::Snapshot<VersionedDigraph, Node> {
+    public:
+        using StoreType = VersionedDigraph;
+        using detail::Snapshot<VersionedDigraph, Node>::Snapshot;
+    };
+
+    /**
+     * @brief Constructs an empty graph.
+     *
+     * @param initialCapacity Number of nodes for which storage is allocated up front.
+     * @param maxReaders Maximum number of snapshots alive at once, 0 for a default.
+     */
+    explicit VersionedDigraph(size_t initialCapacity = 64, size_t maxReaders = 0)
+        : Base(initialCapacity, maxReaders) {}
+
+    /**
+     * @brief Adds a node. Writer only; visible after `publish()`.
+     *
+     * @return The index of the new node.
+     */
+    template <typename... Args>
+    size_t emplace_node(Args&&... args) { return Base::appendNode(std::forward<Args>(args)...); }
+
+    /**
+     * @brief Adds a directed edge. Writer only; visible after `publish()`.
+     *
+     * @param from The index of the source node.
+     * @param to The index of the target node.
+     * @throw std::out_of_range If either index is invalid.
+     */
+    void addEdge(size_t from, size_t to) {
+        Base::validateIndex(from);
+        Base::validateIndex(to);
+        Base::appendEdge(from, to);
+    }
+
+    /**
+     * @brief Takes a snapshot of the last published version. Safe from any thread.
+     *
+     * @throw std::length_error If `maxReaders` snapshots are already alive.
+     */
+    Snapshot snapshot() const { return Base::template takeSnapshot<Snapshot>(this); }
+};
+
+/**
+ * @brief An undirected graph with snapshot isolation, see `VersionedDigraph`.
+ *
+ * Both directions of an edge are published together, so every snapshot is symmetric.
+ *
+ * @tparam T The type of the value stored in each node.
+ */
+template <typename T>
+class VersionedGraph : public VersionedDigraph<T> {
+    using Base = VersionedDigraph<T>;
+
+public:
+    using Base::Base;
+
+    /**
+     * @brief Adds an undirected edge. A self-loop is stored once. Writer only.
+     *
+     * @param from The index of the first node.
+     * @param to The index of the second node.
+     * @throw std::out_of_range If either index is invalid.
+     */
+    void addEdge(size_t from, size_t to) {
+        Base::addEdge(from, to);
+        if (from != to) {
+            Base::addEdge(to, from);
+        }
+    }
+};
+
+} // namespace concurrent
+} // namespace vpr
+
+#endif // VERSIONED_GRAPH_HPP
@@ -1,12 +1,53 @@
 #ifndef GRAPH_TEMPLATE_HPP
 #define GRAPH_TEMPLATE_HPP
 
+#include "thread_pool.hpp"
+#include "work_stealing.hpp"
+
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Standard execution policies are opt-in: with libstdc++ they require linking against TBB.
+#if defined(VPR_USE_EXECUTION_POLICIES) && __cplusplus >= 201703L
+#include <execution>
+#endif
 
 namespace vpr {
 namespace templates {
 
+/**
+ * @brief Policy used to store the edges of each node.
+ */
+enum class AdjacencyMode {
+    Append,       ///< Edges are appended in insertion order, duplicates are kept.
+    SortedUnique  ///< Edges are kept sorted and free of duplicates.
+};
+
+/**
+ * @brief Breakdown of the memory held by a graph or a tree, in bytes.
+ *
+ * The objects of the graph itself are not included, only the storage they own.
+ */
+struct MemoryUsage {
+    size_t nodeBytes = 0;       ///< Node objects in use, including inline values and edge container headers.
+    size_t edgeBytes = 0;       ///< Edge entries in use.
+    size_t nodeSlackBytes = 0;  ///< Unused capacity of the node container.
+    size_t edgeSlackBytes = 0;  ///< Unused capacity of all the edge containers.
+    size_t auxiliaryBytes = 0;  ///< Allocated per-node bookkeeping: tombstones, tree depths and child indices.
+    size_t valueHeapBytes = 0;  ///< Heap owned by the node values, as reported by the user hook.
+
+    inline size_t slackBytes() const noexcept { return nodeSlackBytes + edgeSlackBytes; }
+
+    inline size_t total() const noexcept {
+        return nodeBytes + edgeBytes + slackBytes() + auxiliaryBytes + valueHeapBytes;
+    }
+};
+
 /**
  * @brief Generic container representing a graph structure.
  * 
@@ -27,7 +68,83 @@ protected:
      */
     Container<Node, Allocator> nodes_;
 
+    AdjacencyMode adjacency_mode_ = AdjacencyMode::Append; ///< How `addEdge` stores new edges.
+    bool sorted_ = true; ///< Whether every edge container is currently sorted and unique.
+
+    std::vector<uint8_t> removed_; ///< Tombstone flag per node, left empty until the first removal.
+    size_t removed_count_ = 0;     ///< Number of tombstoned nodes.
+
 public:
+    /**
+     * @brief Bidirectional iterator over the nodes of the graph that skips removed nodes.
+     * 
+     * Unlike the node container's own iterators it is not random access; use `nodes()`
+     * for positional access over every slot, removed ones included.
+     * 
+     * @tparam BaseIterator The iterator of the underlying node container.
+     */
+    template <typename BaseIterator>
+    class LiveIterator {
+        BaseIterator it_;                     ///< Current position in the node container.
+        BaseIterator end_;                    ///< End of the node container.
+        const std::vector<uint8_t>* removed_; ///< Tombstones of the graph being iterated.
+
+        void skipRemoved() {
+            if (removed_->empty()) {
+                return;
+            }
+            while (it_ != end_ && (*removed_)[it_->index()]) {
+                ++it_;
+            }
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = typename std::iterator_traits<BaseIterator>::difference_type;
+        using pointer = typename std::iterator_traits<BaseIterator>::pointer;
+        using reference = typename std::iterator_traits<BaseIterator>::reference;
+
+        LiveIterator(BaseIterator it, BaseIterator end, const std::vector<uint8_t>* removed)
+            : it_(it), end_(end), removed_(removed) { skipRemoved(); }
+
+        reference operator*() const { return *it_; }
+        pointer operator->() const { return &*it_; }
+
+        LiveIterator& operator++() {
+            ++it_;
+            skipRemoved();
+            return *this;
+        }
+
+        LiveIterator operator++(int) {
+            LiveIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        LiveIterator& operator--() {
+            do {
+                --it_;
+            } while (!removed_->empty() && (*removed_)[it_->index()]);
+            return *this;
+        }
+
+        LiveIterator operator--(int) {
+            LiveIterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const LiveIterator& other) const { return it_ == other.it_; }
+        bool operator!=(const LiveIterator& other) const { return it_ != other.it_; }
+    };
+
+    using iterator = LiveIterator<typename Container<Node, Allocator>::iterator>;
+    using const_iterator = LiveIterator<typename Container<Node, Allocator>::const_iterator>;
+    using reverse_iterator = LiveIterator<typename Container<Node, Allocator>::reverse_iterator>;
+    using const_reverse_iterator = LiveIterator<typename Container<Node, Allocator>::const_reverse_iterator>;
+
     /**
      * @brief Constructs an empty graph with an optional initial capacity.
      * 
@@ -46,7 +163,10 @@ public:
      * 
      * @param other The graph to copy from.
      */
-    Graph(const Graph& other) : nodes_(other.nodes_.get_allocator()) {
+    Graph(const Graph& other)
+        : nodes_(other.nodes_.get_allocator()),
+          adjacency_mode_(other.adjacency_mode_), sorted_(other.sorted_),
+          removed_(other.removed_), removed_count_(other.removed_count_) {
         nodes_.reserve(other.nodes_.size());
         nodes_ = other.nodes_;
     }
@@ -58,7 +178,10 @@ public:
      * 
      * @param other The graph to move from.
      */
-    Graph(Graph&& other) noexcept : nodes_(std::move(other.nodes_))
+    Graph(Graph&& other) noexcept
+        : nodes_(std::move(other.nodes_)),
+          adjacency_mode_(other.adjacency_mode_), sorted_(other.sorted_),
+          removed_(std::move(other.removed_)), removed_count_(other.removed_count_)
     { }
 
     /**
@@ -72,6 +195,10 @@ public:
     Graph& operator=(const Graph& other) {
         if (this != &other) {
             nodes_ = other.nodes_;
+            adjacency_mode_ = other.adjacency_mode_;
+            sorted_ = other.sorted_;
+            removed_ = other.removed_;
+            removed_count_ = other.removed_count_;
         }
         return *this;
     }
@@ -86,6 +213,10 @@ public:
      */
     Graph& operator=(Graph&& other) noexcept {
         nodes_ = std::move(other.nodes_);
+        adjacency_mode_ = other.adjacency_mode_;
+        sorted_ = other.sorted_;
+        removed_ = std::move(other.removed_);
+        removed_count_ = other.removed_count_;
         return *this;
     }
 
@@ -96,6 +227,186 @@ public:
      */
     void clear() noexcept {
         nodes_.clear();
+        sorted_ = true;
+        removed_.clear();
+        removed_count_ = 0;
+    }
+
+    /**
+     * @brief Reserves storage for a number of nodes.
+     * 
+     * @param capacity The number of nodes to reserve space for.
+     */
+    void reserve(size_t capacity) { nodes_.reserve(capacity); }
+
+    /**
+     * @brief Reserves storage for a total number of edge entries spread evenly over the live nodes.
+     *
+     * Every live node can then hold `ceil(total / liveSize())` edges without reallocating. An
+     * undirected edge takes two entries. Use `reserveEdges(degrees)` when the degrees are skewed.
+     *
+     * @param total The number of edge entries to reserve space for.
+     */
+    void reserveEdges(size_t total) {
+        const size_t live = liveSize();
+        if (live == 0) {
+            return;
+        }
+        const size_t perNode = (total + live - 1) / live;
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (!isRemoved(i)) {
+                nodes_[i].reserveEdges(perNode);
+            }
+        }
+    }
+
+    /**
+     * @brief Reserves storage for the expected degree of every node.
+     *
+     * @param degrees The number of edges to reserve space for, per node index.
+     * @throw std::invalid_argument If `degrees` does not have one entry per node.
+     */
+    void reserveEdges(const std::vector<size_t>& degrees) {
+        if (degrees.size() != nodes_.size()) {
+            throw std::invalid_argument("Invalid degree count.");
+        }
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (!isRemoved(i)) {
+                nodes_[i].reserveEdges(degrees[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Releases the unused capacity of the node container and of every edge container.
+     *
+     * Node indices are unchanged; removed nodes keep their slot until `compact()`.
+     */
+    void shrink_to_fit() {
+        nodes_.shrink_to_fit();
+        for (auto& node : nodes_) {
+            node.shrinkEdges();
+        }
+        removed_.shrink_to_fit();
+    }
+
+    /**
+     * @brief Returns the memory held by the graph, without the heap owned by the node values.
+     *
+     * @return The breakdown of the memory usage.
+     */
+    MemoryUsage memoryUsage() const {
+        return memoryUsage([](const typename Node::DataType&) { return size_t(0); });
+    }
+
+    /**
+     * @brief Returns the memory held by the graph, including the heap owned by the node values.
+     *
+     * Runs in O(nodes). Removed nodes are counted until `compact()` releases their slots.
+     *
+     * @tparam ValueHeapFn Callable `size_t(const T&)`.
+     * @param valueHeap Function returning the heap bytes owned by a value, e.g. the capacity of a string.
+     * @return The breakdown of the memory usage.
+     */
+    template <typename ValueHeapFn>
+    MemoryUsage memoryUsage(ValueHeapFn valueHeap) const {
+        MemoryUsage usage;
+        usage.nodeBytes = nodes_.size() * sizeof(Node);
+        usage.nodeSlackBytes = (nodes_.capacity() - nodes_.size()) * sizeof(Node);
+        for (const auto& node : nodes_) {
+            const auto& edges = node.edges();
+            const size_t entry = sizeof(typename std::decay<decltype(edges)>::type::value_type);
+            usage.edgeBytes += edges.size() * entry;
+            usage.edgeSlackBytes += (edges.capacity() - edges.size()) * entry;
+            usage.valueHeapBytes += valueHeap(node.value());
+        }
+        usage.auxiliaryBytes = removed_.capacity() * sizeof(uint8_t);
+        return usage;
+    }
+
+    /**
+     * @brief Returns the policy used to store new edges.
+     * 
+     * @return The current adjacency mode.
+     */
+    inline AdjacencyMode adjacencyMode() const noexcept { return adjacency_mode_; }
+
+    /**
+     * @brief Changes the policy used to store new edges.
+     * 
+     * Switching to `AdjacencyMode::SortedUnique` normalizes the existing edges first, so that
+     * every edge container satisfies the sorted and unique invariant.
+     * 
+     * @param mode The new adjacency mode.
+     */
+    void setAdjacencyMode(AdjacencyMode mode) {
+        if (mode == AdjacencyMode::SortedUnique && !sorted_) {
+            normalize();
+        }
+        adjacency_mode_ = mode;
+    }
+
+    /**
+     * @brief Checks whether all edge containers are sorted and free of duplicates.
+     * 
+     * This is always the case in `AdjacencyMode::SortedUnique`, right after `normalize()`,
+     * and as long as edges are appended in increasing target order (e.g. tree children).
+     * 
+     * @return `true` if the edges are sorted and unique, otherwise `false`.
+     */
+    inline bool isNormalized() const noexcept { return sorted_; }
+
+    /**
+     * @brief Sorts the edges of every node and removes duplicates.
+     * 
+     * Intended to run once after bulk loading in `AdjacencyMode::Append`. Large graphs are
+     * processed by a team of `nThreads` work-stealing workers.
+     * 
+     * @param nThreads Number of threads to use, including the calling thread.
+     */
+    void normalize(size_t nThreads = parallel::hardwareConcurrency()) {
+        const size_t grain = 1024;
+        const size_t nChunks = (nodes_.size() + grain - 1) / grain;
+        if (nThreads > nChunks) {
+            nThreads = nChunks;
+        }
+        if (nThreads <= 1) {
+            for (auto& node : nodes_) {
+                node.normalizeEdges();
+            }
+        } else {
+            parallel::ChunkScheduler scheduler(nThreads);
+            scheduler.reset(nChunks);
+            parallel::runTeam(nThreads, [&](size_t worker) {
+                size_t chunk;
+                while (scheduler.next(worker, chunk)) {
+                    const size_t end = std::min(nodes_.size(), (chunk + 1) * grain);
+                    for (size_t i = chunk * grain; i < end; ++i) {
+                        nodes_[i].normalizeEdges();
+                    }
+                }
+            });
+        }
+        sorted_ = true;
+    }
+
+    /**
+     * @brief Checks whether there is an edge from one node to another.
+     * 
+     * Uses a binary search (or a branch-free scan for short lists) while the edges are
+     * normalized, and falls back to a linear scan otherwise.
+     * 
+     * @param from Index of the source node.
+     * @param to Index of the target node.
+     * @return `true` if the edge exists, otherwise `false`.
+     * @throw std::out_of_range If `from` is invalid.
+     */
+    bool hasEdge(size_t from, size_t to) const {
+        const Node& node = nodes_.at(from);
+        if (to >= nodes_.size() || isRemoved(to)) {
+            return false;
+        }
+        return sorted_ ? node.hasEdgeSorted(to) : node.hasEdge(to);
     }
 
     /**
@@ -111,9 +422,66 @@ public:
     size_t emplace_node(Args&&... args) {
         size_t node_index = nodes_.size();
         nodes_.emplace_back(node_index, std::forward<Args>(args)...);
+        if (!removed_.empty()) {
+            removed_.push_back(0);
+        }
         return node_index;
     }
 
+    /**
+     * @brief Checks whether a node has been removed and is waiting for `compact()`.
+     * 
+     * @param index The index of the node, which must be lower than `size()`.
+     * @return `true` if the node is a tombstone, otherwise `false`.
+     */
+    inline bool isRemoved(size_t index) const noexcept {
+        return !removed_.empty() && removed_[index];
+    }
+
+    /**
+     * @brief Returns the number of nodes that have not been removed.
+     * 
+     * @return The number of live nodes.
+     */
+    inline size_t liveSize() const noexcept { return nodes_.size() - removed_count_; }
+
+    /**
+     * @brief Drops the removed nodes and renumbers the live ones into dense storage.
+     * 
+     * Live nodes keep their relative order, so sorted edge containers stay sorted. Edges to
+     * removed nodes that were not pruned at removal time (e.g. incoming edges of a digraph)
+     * are dropped here. Runs in O(nodes + edges).
+     * 
+     * @return A table mapping every old index to its new index, or to
+     *         `static_cast<size_t>(-1)` for removed nodes.
+     */
+    std::vector<size_t> compact() {
+        std::vector<size_t> remap(nodes_.size());
+        size_t next = 0;
+        for (size_t i = 0; i < remap.size(); ++i) {
+            remap[i] = isRemoved(i) ? static_cast<size_t>(-1) : next++;
+        }
+        if (removed_count_ == 0) {
+            return remap;
+        }
+
+        for (size_t i = 0; i < remap.size(); ++i) {
+            if (remap[i] == static_cast<size_t>(-1)) {
+                continue;
+            }
+            if (remap[i] != i) {
+                nodes_[remap[i]] = std::move(nodes_[i]);
+            }
+            nodes_[remap[i]].remap(remap);
+        }
+        while (nodes_.size() > next) {
+            nodes_.pop_back();
+        }
+        removed_.clear();
+        removed_count_ = 0;
+        return remap;
+    }
+
     /**
      * @brief Access a node by its index.
      * 
@@ -150,61 +518,131 @@ public:
      */
     inline bool empty() const noexcept { return nodes_.empty(); }
 
+    /**
+     * @brief Returns the underlying node container, removed nodes included.
+     * 
+     * Slot `i` holds the node with index `i`; check `isRemoved(i)` before using it.
+     * 
+     * @return Constant reference to the node container.
+     */
+    const Container<Node, Allocator>& nodes() const noexcept { return nodes_; }
+
     /**
      * @brief Returns an iterator to the beginning of the nodes.
      * 
+     * All node iterators skip removed nodes.
+     * 
      * @return Iterator pointing to the first node.
      */
-    typename Container<Node, Allocator>::iterator begin() noexcept { return nodes_.begin(); }
+    iterator begin() noexcept { return iterator(nodes_.begin(), nodes_.end(), &removed_); }
 
     /**
      * @brief Returns an iterator to the end of the nodes.
      * 
      * @return Iterator pointing past the last node.
      */
-    typename Container<Node, Allocator>::iterator end() noexcept { return nodes_.end(); }
+    iterator end() noexcept { return iterator(nodes_.end(), nodes_.end(), &removed_); }
 
     /**
      * @brief Returns a reverse iterator to the beginning of the nodes in reverse order.
      * 
      * @return Reverse iterator pointing to the last node.
      */
-    typename Container<Node, Allocator>::reverse_iterator rbegin() noexcept { return nodes_.rbegin(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(nodes_.rbegin(), nodes_.rend(), &removed_); }
 
     /**
      * @brief Returns a reverse iterator to the end of the nodes in reverse order.
      * 
      * @return Reverse iterator pointing before the first node.
      */
-    typename Container<Node, Allocator>::reverse_iterator rend() noexcept { return nodes_.rend(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(nodes_.rend(), nodes_.rend(), &removed_); }
 
     /**
      * @brief Const version of the iterator to the beginning of nodes.
      * 
      * @return Const iterator pointing to the first node.
      */
-    typename Container<Node, Allocator>::const_iterator begin() const noexcept { return nodes_.begin(); }
+    const_iterator begin() const noexcept { return const_iterator(nodes_.begin(), nodes_.end(), &removed_); }
 
     /**
      * @brief Const version of the iterator to the end of nodes.
      * 
      * @return Const iterator pointing past the last node.
      */
-    typename Container<Node, Allocator>::const_iterator end() const noexcept { return nodes_.end(); }
+    const_iterator end() const noexcept { return const_iterator(nodes_.end(), nodes_.end(), &removed_); }
 
     /**
      * @brief Const version of the reverse iterator to the beginning of nodes in reverse order.
      * 
      * @return Const reverse iterator pointing to the last node.
      */
-    typename Container<Node, Allocator>::const_reverse_iterator rbegin() const noexcept { return nodes_.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(nodes_.rbegin(), nodes_.rend(), &removed_); }
 
     /**
      * @brief Const version of the reverse iterator to the end of nodes in reverse order.
      * 
      * @return Const reverse iterator pointing before the first node.
      */
-    typename Container<Node, Allocator>::const_reverse_iterator rend() const noexcept { return nodes_.rend(); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(nodes_.rend(), nodes_.rend(), &removed_); }
+
+    /**
+     * @brief Calls `fn(node)` for every live node on the workers of an executor.
+     * 
+     * The index range is split into chunks of `grain` consecutive nodes that idle workers
+     * steal from each other. `fn` may update the node it receives, but must not add or
+     * remove nodes nor touch other nodes. If `fn` throws, the remaining chunks are skipped
+     * and the first exception is rethrown once every worker has stopped.
+     * 
+     * @tparam Executor An executor such as `parallel::ThreadPool`.
+     * @tparam Fn Callable `void(Node&)`.
+     * @param executor The executor running the workers.
+     * @param fn Function applied to every live node.
+     * @param grain Number of consecutive nodes handed to a worker at a time.
+     */
+    template <typename Executor, typename Fn,
+              typename = typename std::enable_if<parallel::IsExecutor<Executor>::value>::type>
+    void parallel_for_each_node(Executor& executor, Fn fn, size_t grain = 1024) {
+        forEachNodeRange(*this, executor, fn, grain);
+    }
+
+    template <typename Executor, typename Fn,
+              typename = typename std::enable_if<parallel::IsExecutor<Executor>::value>::type>
+    void parallel_for_each_node(Executor& executor, Fn fn, size_t grain = 1024) const {
+        forEachNodeRange(*this, executor, fn, grain);
+    }
+
+    /**
+     * @brief Calls `fn(node)` for every live node on `parallel::defaultPool()`.
+     * 
+     * @tparam Fn Callable `void(Node&)`.
+     * @param fn Function applied to every live node.
+     * @param grain Number of consecutive nodes handed to a worker at a time.
+     */
+    template <typename Fn>
+    void parallel_for_each_node(Fn fn, size_t grain = 1024) {
+        forEachNodeRange(*this, parallel::defaultPool(), fn, grain);
+    }
+
+    template <typename Fn>
+    void parallel_for_each_node(Fn fn, size_t grain = 1024) const {
+        forEachNodeRange(*this, parallel::defaultPool(), fn, grain);
+    }
+
+#if defined(VPR_USE_EXECUTION_POLICIES) && __cplusplus >= 201703L
+    /**
+     * @brief Calls `fn(node)` for every live node with a standard execution policy, e.g.
+     * `std::execution::par`. Requires C++17 and `VPR_USE_EXECUTION_POLICIES`.
+     */
+    template <typename ExecutionPolicy, typename Fn,
+              typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+    void parallel_for_each_node(ExecutionPolicy&& policy, Fn fn) {
+        std::for_each(std::forward<ExecutionPolicy>(policy), nodes_.begin(), nodes_.end(), [&](Node& node) {
+            if (!isRemoved(node.index())) {
+                fn(node);
+            }
+        });
+    }
+#endif
 
     /**
      * @brief Outputs the graph to an output stream.
@@ -216,7 +654,7 @@ public:
      * @return A reference to the output stream.
      */
     friend std::ostream& operator<<(std::ostream& os, const Graph& graph) {
-        for (const auto& node : graph.nodes_) {
+        for (const auto& node : graph) {
             os << node << " ";
         }
         return os;
@@ -227,14 +665,181 @@ protected:
      * @brief Adds an edge between two nodes.
      * 
      * Validates indices before creating a connection from one node to another.
+     * In `AdjacencyMode::SortedUnique` the edge is inserted at its sorted position and
+     * ignored if it already exists.
      * 
      * @param from Index of the starting node.
      * @param to Index of the target node.
      * @throw std::out_of_range If either index is invalid.
+     * @throw std::invalid_argument If either node is removed.
      */
     void addEdge(size_t from, size_t to) {
         validateIndex(to);
-        nodes_.at(from).addEdge(to);
+        Node& node = nodes_.at(from);
+        if (isRemoved(from) || isRemoved(to)) {
+            throw std::invalid_argument("Cannot add an edge to a removed node.");
+        }
+        if (adjacency_mode_ == AdjacencyMode::SortedUnique) {
+            node.insertEdgeSorted(to);
+            return;
+        }
+        if (sorted_ && !node.isolated() && node.edges().back() >= to) {
+            sorted_ = false;
+        }
+        node.addEdge(to);
+    }
+
+    /**
+     * @brief Removes one edge from one node to another.
+     * 
+     * Runs in O(degree of `from`) and keeps the order of the remaining edges.
+     * 
+     * @param from Index of the starting node.
+     * @param to Index of the target node.
+     * @return `true` if an edge was removed, `false` if there was none.
+     * @throw std::out_of_range If `from` is invalid.
+     */
+    bool removeEdge(size_t from, size_t to) {
+        return nodes_.at(from).removeEdge(to);
+    }
+
+    /**
+     * @brief Replaces the edges of every node with a CSR adjacency.
+     * 
+     * The targets of node `i` are `targets[offsets[i]]` to `targets[offsets[i + 1] - 1]`,
+     * stored in that order. Every edge container is assigned once. Whether the result is
+     * normalized is detected; in `AdjacencyMode::SortedUnique` it is normalized if needed.
+     * 
+     * @tparam Index Integer type of the CSR arrays.
+     * @param offsets `size() + 1` non-decreasing offsets into `targets`, starting at 0.
+     * @param targets The target indices.
+     * @throw std::invalid_argument If the offsets are inconsistent.
+     * @throw std::out_of_range If a target index is invalid.
+     */
+    template <typename Index>
+    void assignAdjacency(const std::vector<Index>& offsets, const std::vector<Index>& targets) {
+        const size_t n = nodes_.size();
+        if (offsets.size() != n + 1 || offsets[0] != 0 || static_cast<size_t>(offsets[n]) != targets.size()) {
+            throw std::invalid_argument("Invalid adjacency offsets.");
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (offsets[i] > offsets[i + 1]) {
+                throw std::invalid_argument("Invalid adjacency offsets.");
+            }
+        }
+        bool sorted = true;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t e = offsets[i]; e < static_cast<size_t>(offsets[i + 1]); ++e) {
+                validateIndex(static_cast<size_t>(targets[e]));
+                if (e > static_cast<size_t>(offsets[i]) && targets[e - 1] >= targets[e]) {
+                    sorted = false;
+                }
+            }
+            nodes_[i].assignEdges(targets.begin() + offsets[i], targets.begin() + offsets[i + 1]);
+        }
+        sorted_ = sorted;
+        if (!sorted_ && adjacency_mode_ == AdjacencyMode::SortedUnique) {
+            normalize();
+        }
+    }
+
+    /**
+     * @brief Marks a node as removed and drops its outgoing edges.
+     * 
+     * The node keeps its slot (and index) until `compact()` is called. Edges pointing to it
+     * from other nodes must be removed by the caller or are pruned by `compact()`.
+     * 
+     * @param index Index of the node to remove.
+     * @return `true` if the node was removed, `false` if it already was.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    bool markRemoved(size_t index) {
+        validateIndex(index);
+        if (removed_.empty()) {
+            removed_.assign(nodes_.size(), 0);
+        }
+        if (removed_[index]) {
+            return false;
+        }
+        removed_[index] = 1;
+        ++removed_count_;
+        nodes_[index].clearEdges();
+        return true;
+    }
+
+    /**
+     * @brief Moves every node to a new index and rewrites all edges accordingly.
+     * 
+     * Nodes are moved along the cycles of the permutation, so no node is copied. If the edge
+     * containers were normalized they are sorted again afterwards.
+     * 
+     * @param permutation Table mapping every old node index to its new index.
+     * @throw std::invalid_argument If `permutation` is not a permutation of the node indices.
+     */
+    void permute(const std::vector<size_t>& permutation) {
+        const size_t n = nodes_.size();
+        std::vector<size_t> inverse(n, static_cast<size_t>(-1));
+        if (permutation.size() != n) {
+            throw std::invalid_argument("Invalid permutation.");
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (permutation[i] >= n || inverse[permutation[i]] != static_cast<size_t>(-1)) {
+                throw std::invalid_argument("Invalid permutation.");
+            }
+            inverse[permutation[i]] = i;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            nodes_[i].remap(permutation);
+        }
+        std::vector<char> placed(n, 0);
+        for (size_t start = 0; start < n; ++start) {
+            if (placed[start] || inverse[start] == start) {
+                continue;
+            }
+            Node carried(std::move(nodes_[start]));
+            size_t position = start;
+            while (true) {
+                placed[position] = 1;
+                size_t source = inverse[position];
+                if (source == start) {
+                    nodes_[position] = std::move(carried);
+                    break;
+                }
+                nodes_[position] = std::move(nodes_[source]);
+                position = source;
+            }
+        }
+
+        if (!removed_.empty()) {
+            std::vector<uint8_t> removed(n);
+            for (size_t i = 0; i < n; ++i) {
+                removed[permutation[i]] = removed_[i];
+            }
+            removed_.swap(removed);
+        }
+        if (sorted_) {
+            normalize();
+        }
+    }
+
+    /**
+     * @brief Shared implementation of the const and non-const `parallel_for_each_node`.
+     */
+    template <typename Self, typename Executor, typename Fn>
+    static void forEachNodeRange(Self& self, Executor& executor, Fn& fn, size_t grain) {
+        const size_t n = self.nodes_.size();
+        if (grain == 0) {
+            grain = 1;
+        }
+        parallel::parallelFor(executor, (n + grain - 1) / grain, [&](size_t chunk) {
+            const size_t end = std::min(n, (chunk + 1) * grain);
+            for (size_t i = chunk * grain; i < end; ++i) {
+                if (!self.isRemoved(i)) {
+                    fn(self.nodes_[i]);
+                }
+            }
+        });
     }
 
     /**
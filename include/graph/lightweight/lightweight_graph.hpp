@@ -3,6 +3,7 @@
 
 #include "graph_template.hpp"
 #include "node_template.hpp"
+#include "reorder.hpp"
 
 namespace vpr {
 namespace lightweight {
@@ -45,13 +46,92 @@ public:
      * 
      * Adds an edge from the node with index `from` to the node with index `to` and 
      * vice versa, as this is an undirected graph. This method establishes a bidirectional connection.
+     * A self-loop (`from == to`) is stored only once.
      * 
      * @param from The index of the first node.
      * @param to The index of the second node.
+     * @throw std::out_of_range If either index is invalid.
+     * @throw std::invalid_argument If either node is removed.
      */
     void addEdge(size_t from, size_t to) {
         Base::addEdge(from, to);
-        Base::addEdge(to, from);
+        if (from != to) {
+            Base::addEdge(to, from);
+        }
+    }
+
+    /**
+     * @brief Removes an undirected edge between two nodes.
+     * 
+     * Removes one occurrence of the edge in both directions. Runs in O(degree).
+     * 
+     * @param from The index of the first node.
+     * @param to The index of the second node.
+     * @return `true` if the edge existed, otherwise `false`.
+     * @throw std::out_of_range If either index is invalid.
+     */
+    bool removeEdge(size_t from, size_t to) {
+        Base::validateIndex(to);
+        if (!Base::removeEdge(from, to)) {
+            return false;
+        }
+        if (from != to) {
+            Base::removeEdge(to, from);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes a node and all the edges incident to it.
+     * 
+     * The node becomes a tombstone: it is skipped by the node iterators and its slot is
+     * reclaimed by `compact()`. Runs in O(sum of the degrees of its neighbours).
+     * 
+     * @param index The index of the node to remove.
+     * @return `true` if the node was removed, `false` if it already was.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    bool removeNode(size_t index) {
+        Base::validateIndex(index);
+        for (size_t neighbour : this->nodes_[index].edges()) {
+            if (neighbour != index) {
+                this->nodes_[neighbour].removeEdges(index);
+            }
+        }
+        return Base::markRemoved(index);
+    }
+
+    /**
+     * @brief Replaces all the edges of the graph with a CSR adjacency, for bulk loading.
+     * 
+     * The neighbours of node `i` are `targets[offsets[i]]` to `targets[offsets[i + 1] - 1]`.
+     * The adjacency must be symmetric: every edge is listed from both ends, and self-loops
+     * once, as `addEdge` stores them. Symmetry is not checked.
+     * 
+     * @tparam Index Integer type of the CSR arrays.
+     * @param offsets `size() + 1` non-decreasing offsets into `targets`, starting at 0.
+     * @param targets The target indices.
+     * @throw std::invalid_argument If the offsets are inconsistent.
+     * @throw std::out_of_range If a target index is invalid.
+     */
+    template <typename Index>
+    void assignAdjacency(const std::vector<Index>& offsets, const std::vector<Index>& targets) {
+        Base::assignAdjacency(offsets, targets);
+    }
+
+    /**
+     * @brief Renumbers the nodes to improve memory locality.
+     * 
+     * Node storage is permuted and every edge index is rewritten, so that nodes visited
+     * together end up close in memory. Meant to be run once after loading the graph.
+     * 
+     * @param strategy The ordering strategy.
+     * @return A permutation mapping every old node index to its new index.
+     */
+    std::vector<size_t> reorder(algorithms::ReorderStrategy strategy) {
+        std::vector<size_t> permutation = algorithms::computeOrdering(*this, strategy);
+        Base::permute(permutation);
+        return permutation;
     }
 
 };
@@ -1,6 +1,8 @@
 #ifndef NODE_TEMPLATE_HPP
 #define NODE_TEMPLATE_HPP
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -31,6 +33,8 @@ public:
 
     using DataType = T; ///< Alias for the type of data stored in the node.
 
+    static constexpr size_t SHORT_EDGE_LIST = 16; ///< Lists up to this size are searched linearly.
+
     /**
      * @brief Constructs a node with a given index and a value.
      * 
@@ -113,6 +117,27 @@ public:
         edges_.reserve(n);
     }
 
+    /**
+     * @brief Releases the unused capacity of the edge container.
+     */
+    void shrinkEdges() {
+        edges_.shrink_to_fit();
+    }
+
+    /**
+     * @brief Replaces all the edges of the node with a range of target indices.
+     * 
+     * The edge container is resized once, so bulk loaders allocate at most once per node.
+     * 
+     * @tparam InputIt Iterator over values convertible to `size_t`.
+     * @param first Beginning of the range of target indices.
+     * @param last End of the range of target indices.
+     */
+    template <typename InputIt>
+    void assignEdges(InputIt first, InputIt last) {
+        edges_.assign(first, last);
+    }
+
     /**
      * @brief Emplaces a new value in the node, replacing the current one.
      * 
@@ -205,6 +230,118 @@ public:
      */
     void addEdge(size_t fromIndex) { edges_.push_back(fromIndex); }
 
+    /**
+     * @brief Inserts an edge keeping the edge container sorted and free of duplicates.
+     * 
+     * The edge container must already be sorted and unique (see `normalizeEdges`).
+     * 
+     * @param toIndex Index of the node to which this node is being connected.
+     * @return `true` if the edge was inserted, `false` if it was already present.
+     */
+    bool insertEdgeSorted(size_t toIndex) {
+        auto it = std::lower_bound(edges_.begin(), edges_.end(), toIndex);
+        if (it != edges_.end() && *it == toIndex) {
+            return false;
+        }
+        edges_.insert(it, toIndex);
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the node has an edge to another node.
+     * 
+     * Performs a linear scan, so it works whatever the order of the edges.
+     * 
+     * @param toIndex Index of the target node.
+     * @return `true` if the edge exists, otherwise `false`.
+     */
+    bool hasEdge(size_t toIndex) const {
+        return std::find(edges_.begin(), edges_.end(), toIndex) != edges_.end();
+    }
+
+    /**
+     * @brief Checks whether the node has an edge to another node, assuming sorted edges.
+     * 
+     * Short lists are scanned without branches, which compilers turn into SIMD compares;
+     * longer lists use a binary search.
+     * 
+     * @param toIndex Index of the target node.
+     * @return `true` if the edge exists, otherwise `false`.
+     */
+    bool hasEdgeSorted(size_t toIndex) const {
+        if (edges_.size() <= SHORT_EDGE_LIST) {
+            bool found = false;
+            for (size_t edge : edges_) {
+                found |= (edge == toIndex);
+            }
+            return found;
+        }
+        return std::binary_search(edges_.begin(), edges_.end(), toIndex);
+    }
+
+    /**
+     * @brief Sorts the edges and removes duplicates.
+     */
+    void normalizeEdges() {
+        std::sort(edges_.begin(), edges_.end());
+        edges_.erase(std::unique(edges_.begin(), edges_.end()), edges_.end());
+    }
+
+    /**
+     * @brief Removes one edge to another node, keeping the order of the remaining edges.
+     * 
+     * @param toIndex Index of the target node.
+     * @return `true` if an edge was removed, `false` if there was none.
+     */
+    bool removeEdge(size_t toIndex) {
+        auto it = std::find(edges_.begin(), edges_.end(), toIndex);
+        if (it == edges_.end()) {
+            return false;
+        }
+        edges_.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Removes every edge to another node, keeping the order of the remaining edges.
+     * 
+     * @param toIndex Index of the target node.
+     * @return The number of edges removed.
+     */
+    size_t removeEdges(size_t toIndex) {
+        auto it = std::remove(edges_.begin(), edges_.end(), toIndex);
+        size_t removed = static_cast<size_t>(std::distance(it, edges_.end()));
+        edges_.erase(it, edges_.end());
+        return removed;
+    }
+
+    /**
+     * @brief Removes all the edges of the node.
+     */
+    void clearEdges() noexcept { edges_.clear(); }
+
+    /**
+     * @brief Renumbers the node and its edges after the graph storage has been compacted.
+     * 
+     * Edges whose target maps to `static_cast<size_t>(-1)` (a removed node) are dropped.
+     * The relative order of the remaining edges is preserved.
+     * 
+     * @tparam Remap Any table indexable by an old node index, e.g. `std::vector<size_t>`.
+     * @param remap Table mapping every old node index to its new index.
+     */
+    template <typename Remap>
+    void remap(const Remap& remap) {
+        index_ = remap[index_];
+        auto out = edges_.begin();
+        for (auto it = edges_.begin(); it != edges_.end(); ++it) {
+            size_t target = remap[*it];
+            if (target != static_cast<size_t>(-1)) {
+                *out++ = target;
+            }
+        }
+        edges_.erase(out, edges_.end());
+    }
+
     /**
      * @brief Output stream operator for printing the node's value.
      * 
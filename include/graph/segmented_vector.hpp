@@ -0,0 +1,315 @@
+#ifndef SEGMENTED_VECTOR_HPP
+#define SEGMENTED_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace vpr {
+namespace templates {
+
+/**
+ * @brief A sequence container whose elements never move once constructed.
+ *
+ * Elements live in blocks of doubling size: block `k` holds `64 << k` elements, so element
+ * `i` is found in O(1) from the highest set bit of `i + 64`. Growing allocates a new block
+ * instead of relocating the existing ones, which keeps references to elements valid for the
+ * lifetime of the element and avoids the copy spikes of reallocating a large vector.
+ *
+ * The interface mirrors the subset of `std::vector` used by `templates::Graph`, so it can be
+ * plugged into its `Container` parameter, e.g.
+ * `templates::Tree<lightweight::tree::Node<T>, templates::SegmentedVector>`.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Allocator The allocator, rebound to `T` if needed.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class SegmentedVector {
+public:
+    using value_type = T;
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+private:
+    using AllocTraits = std::allocator_traits<allocator_type>;
+
+    static constexpr size_t FIRST_BLOCK_BITS = 6;
+    static constexpr size_t MAX_BLOCKS = 64 - FIRST_BLOCK_BITS;
+
+    allocator_type alloc_;         ///< Allocator of the blocks.
+    T* blocks_[MAX_BLOCKS] = {};   ///< Allocated blocks, `nullptr` past `nBlocks_`.
+    size_t nBlocks_ = 0;           ///< Number of allocated blocks.
+    size_t size_ = 0;              ///< Number of constructed elements.
+
+    static size_t blockOf(size_t index) noexcept {
+        const size_t value = index + (size_t(1) << FIRST_BLOCK_BITS);
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(value))) - FIRST_BLOCK_BITS;
+#else
+        size_t bit = 0;
+        for (size_t v = value; v >>= 1;) {
+            ++bit;
+        }
+        return bit - FIRST_BLOCK_BITS;
+#endif
+    }
+
+    static size_t blockSize(size_t block) noexcept { return size_t(1) << (block + FIRST_BLOCK_BITS); }
+
+    /**
+     * @brief Number of elements held by the blocks before `block`.
+     */
+    static size_t blockStart(size_t block) noexcept { return blockSize(block) - blockSize(0); }
+
+public:
+
+    /**
+     * @brief Random access iterator over the elements, stable while the container grows.
+     *
+     * @tparam Const Whether the iterator gives read-only access.
+     */
+    template <bool Const>
+    class Iterator {
+        using Owner = typename std::conditional<Const, const SegmentedVector, SegmentedVector>::type;
+
+        Owner* owner_; ///< Container being iterated.
+        size_t index_; ///< Index of the current element.
+
+        friend class SegmentedVector;
+        template <bool> friend class Iterator;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
+
+        Iterator() : owner_(nullptr), index_(0) {}
+        Iterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+
+        /**
+         * @brief Converts a mutable iterator to a read-only one.
+         */
+        template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {}
+
+        reference operator*() const { return (*owner_)[index_]; }
+        pointer operator->() const { return &(*owner_)[index_]; }
+        reference operator[](difference_type n) const { return (*owner_)[index_ + n]; }
+
+        Iterator& operator++() { ++index_; return *this; }
+        Iterator& operator--() { --index_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+        Iterator operator--(int) { Iterator tmp = *this; --index_; return tmp; }
+        Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(owner_, index_ + n); }
+        Iterator operator-(difference_type n) const { return Iterator(owner_, index_ - n); }
+        friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+
+        difference_type operator-(const Iterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+        bool operator<(const Iterator& other) const { return index_ < other.index_; }
+        bool operator>(const Iterator& other) const { return index_ > other.index_; }
+        bool operator<=(const Iterator& other) const { return index_ <= other.index_; }
+        bool operator>=(const Iterator& other) const { return index_ >= other.index_; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Allocator& alloc) : alloc_(alloc) {}
+
+    SegmentedVector(const SegmentedVector& other)
+        : alloc_(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+        *this = other;
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept : alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) {
+                emplace_back(other[i]);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Takes the blocks of another container; no element is moved.
+     */
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() { release(); }
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    inline size_t size() const noexcept { return size_; }
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline size_t capacity() const noexcept { return nBlocks_ == 0 ? 0 : blockStart(nBlocks_); }
+
+    /**
+     * @brief Allocates the blocks needed to hold `capacity` elements. Never moves elements.
+     *
+     * @param capacity The number of elements.
+     */
+    void reserve(size_t capacity) {
+        while (this->capacity() < capacity) {
+            if (nBlocks_ == MAX_BLOCKS) {
+                throw std::length_error("Segmented vector is full.");
+            }
+            blocks_[nBlocks_] = AllocTraits::allocate(alloc_, blockSize(nBlocks_));
+            ++nBlocks_;
+        }
+    }
+
+    /**
+     * @brief Frees the blocks past the last element.
+     */
+    void shrink_to_fit() {
+        const size_t needed = size_ == 0 ? 0 : blockOf(size_ - 1) + 1;
+        while (nBlocks_ > needed) {
+            --nBlocks_;
+            AllocTraits::deallocate(alloc_, blocks_[nBlocks_], blockSize(nBlocks_));
+            blocks_[nBlocks_] = nullptr;
+        }
+    }
+
+    T& operator[](size_t index) noexcept {
+        const size_t block = blockOf(index);
+        return blocks_[block][index - blockStart(block)];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        const size_t block = blockOf(index);
+        return blocks_[block][index - blockStart(block)];
+    }
+
+    T& at(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Invalid node index.");
+        }
+        return (*this)[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Invalid node index.");
+        }
+        return (*this)[index];
+    }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size_ - 1]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    /**
+     * @brief Constructs an element at the end, allocating a new block when the last one is full.
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        reserve(size_ + 1);
+        T* slot = &(*this)[size_];
+        AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        --size_;
+        AllocTraits::destroy(alloc_, &(*this)[size_]);
+    }
+
+    /**
+     * @brief Destroys every element, keeping the blocks for reuse.
+     */
+    void clear() noexcept {
+        while (size_ != 0) {
+            pop_back();
+        }
+    }
+
+    void swap(SegmentedVector& other) noexcept {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        std::swap_ranges(blocks_, blocks_ + MAX_BLOCKS, other.blocks_);
+        swap(nBlocks_, other.nBlocks_);
+        swap(size_, other.size_);
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+private:
+
+    void steal(SegmentedVector& other) noexcept {
+        std::copy(other.blocks_, other.blocks_ + MAX_BLOCKS, blocks_);
+        std::fill(other.blocks_, other.blocks_ + MAX_BLOCKS, nullptr);
+        nBlocks_ = other.nBlocks_;
+        size_ = other.size_;
+        other.nBlocks_ = 0;
+        other.size_ = 0;
+    }
+
+    void release() noexcept {
+        clear();
+        while (nBlocks_ != 0) {
+            --nBlocks_;
+            AllocTraits::deallocate(alloc_, blocks_[nBlocks_], blockSize(nBlocks_));
+            blocks_[nBlocks_] = nullptr;
+        }
+    }
+};
+
+template <typename T, typename Allocator>
+constexpr size_t SegmentedVector<T, Allocator>::FIRST_BLOCK_BITS;
+
+template <typename T, typename Allocator>
+constexpr size_t SegmentedVector<T, Allocator>::MAX_BLOCKS;
+
+} // namespace templates
+} // namespace vpr
+
+#endif // SEGMENTED_VECTOR_HPP
@@ -0,0 +1,531 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "graph_template.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Current version of the binary format, bumped on incompatible changes.
+ */
+constexpr uint16_t BINARY_FORMAT_VERSION = 1;
+
+/**
+ * @brief Kind of topology stored in a binary file.
+ */
+enum class TopologyKind : uint8_t {
+    Tree = 1,          ///< One parent id per node; children follow in index order.
+    Adjacency = 2,     ///< CSR offsets and targets, for graphs and digraphs.
+    FlatTree = 3,      ///< Node records with self-relative edge offsets, see `flat_layout.hpp`.
+    FlatAdjacency = 4  ///< Same as `FlatTree`, for graphs and digraphs.
+};
+
+/**
+ * @brief How node values are stored in a binary file.
+ */
+enum class ValueEncoding : uint8_t {
+    Raw = 1,       ///< One contiguous block of `valueSize` bytes per node.
+    Serializer = 2 ///< Written and read back by a user serializer, one value after the other.
+};
+
+/**
+ * @brief Fixed-size header at the start of every binary file.
+ *
+ * The file then holds the topology arrays as 64-bit integers (for a tree the
+ * `nodeCount` parent ids; for a graph `nodeCount + 1` CSR offsets followed by `edgeCount`
+ * targets), then the values. A raw value block is padded to a multiple of 8 bytes, so every
+ * section starts 8-byte aligned. Files are written in host byte order, which `byteOrder`
+ * records; files written on a host of the other endianness are rejected.
+ */
+struct FileHeader {
+    char magic[4];          ///< `'V', 'P', 'R', 'B'`.
+    uint16_t version;       ///< `BINARY_FORMAT_VERSION`.
+    uint8_t kind;           ///< A `TopologyKind`.
+    uint8_t valueEncoding;  ///< A `ValueEncoding`.
+    uint32_t byteOrder;     ///< `0x01020304` as written by the host.
+    uint32_t valueSize;     ///< `sizeof` a value for `ValueEncoding::Raw`, 0 otherwise.
+    uint64_t nodeCount;     ///< Number of nodes stored, removed nodes excluded.
+    uint64_t edgeCount;     ///< Number of adjacency entries stored.
+    uint32_t flags;         ///< Combination of `FLAG_NORMALIZED` and `FLAG_SORTED_UNIQUE`.
+    uint32_t reserved;      ///< Always 0.
+};
+
+constexpr uint32_t FLAG_NORMALIZED = 1;    ///< Every edge list is sorted and unique.
+constexpr uint32_t FLAG_SORTED_UNIQUE = 2; ///< The graph was in `AdjacencyMode::SortedUnique`.
+
+static_assert(sizeof(FileHeader) == 40, "FileHeader must not contain padding.");
+
+namespace detail {
+
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+inline void writeBytes(std::ostream& out, const void* data, size_t size) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out) {
+        throw std::runtime_error("Failed to write binary data.");
+    }
+}
+
+inline void readBytes(std::istream& in, void* data, size_t size) {
+    in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    if (static_cast<size_t>(in.gcount()) != size) {
+        throw std::runtime_error("Unexpected end of binary data.");
+    }
+}
+
+/**
+ * @brief Computes `count * size + extra`, returning `false` if it does not fit in a `size_t`.
+ */
+inline bool checkedSize(uint64_t count, size_t size, size_t extra, size_t& result) {
+    const size_t max = std::numeric_limits<size_t>::max();
+    if (count > max || (size != 0 && count > (max - extra) / size)) {
+        return false;
+    }
+    result = static_cast<size_t>(count) * size + extra;
+    return true;
+}
+
+/**
+ * @brief Returns the number of bytes left in a seekable stream, or the largest `size_t` otherwise.
+ */
+inline size_t remainingBytes(std::istream& in) {
+    const size_t unknown = std::numeric_limits<size_t>::max();
+    const std::streampos position = in.tellg();
+    if (position == std::streampos(-1)) {
+        return unknown;
+    }
+    in.seekg(0, std::ios::end);
+    const std::streampos end = in.tellg();
+    in.clear();
+    in.seekg(position);
+    if (end == std::streampos(-1) || end < position) {
+        return unknown;
+    }
+    return static_cast<size_t>(end - position);
+}
+
+/**
+ * @brief Reads an array of `count` elements, `count` coming from an untrusted header.
+ *
+ * The size is checked for overflow and against the bytes left in the stream before anything
+ * is allocated. On streams that cannot seek the array grows chunk by chunk as data actually
+ * arrives, so a corrupt count fails at the end of the data instead of allocating it.
+ *
+ * @throw std::runtime_error If the data is truncated.
+ */
+template <typename T>
+std::vector<T> readArray(std::istream& in, uint64_t count) {
+    size_t bytes = 0;
+    const size_t remaining = remainingBytes(in);
+    if (!checkedSize(count, sizeof(T), 0, bytes) || bytes > remaining) {
+        throw std::runtime_error("Binary data is truncated.");
+    }
+    std::vector<T> values;
+    if (remaining != std::numeric_limits<size_t>::max()) {
+        values.resize(static_cast<size_t>(count));
+        readBytes(in, values.data(), bytes);
+        return values;
+    }
+    const size_t chunk = (size_t(1) << 20) / sizeof(T) + 1;
+    while (values.size() < count) {
+        const size_t n = std::min(chunk, static_cast<size_t>(count) - values.size());
+        values.resize(values.size() + n);
+        readBytes(in, values.data() + values.size() - n, n * sizeof(T));
+    }
+    return values;
+}
+
+inline void writePadding(std::ostream& out, size_t written) {
+    static const char zeros[8] = {0};
+    if (written % 8 != 0) {
+        writeBytes(out, zeros, 8 - written % 8);
+    }
+}
+
+inline void skipPadding(std::istream& in, size_t read) {
+    char padding[8];
+    if (read % 8 != 0) {
+        readBytes(in, padding, 8 - read % 8);
+    }
+}
+
+inline FileHeader makeHeader(TopologyKind kind, ValueEncoding encoding, size_t valueSize,
+                             size_t nodeCount, size_t edgeCount, uint32_t flags) {
+    FileHeader header;
+    std::memcpy(header.magic, "VPRB", 4);
+    header.version = BINARY_FORMAT_VERSION;
+    header.kind = static_cast<uint8_t>(kind);
+    header.valueEncoding = static_cast<uint8_t>(encoding);
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.valueSize = static_cast<uint32_t>(valueSize);
+    header.nodeCount = nodeCount;
+    header.edgeCount = edgeCount;
+    header.flags = flags;
+    header.reserved = 0;
+    return header;
+}
+
+inline FileHeader readHeader(std::istream& in, TopologyKind kind, ValueEncoding encoding, size_t valueSize) {
+    FileHeader header;
+    readBytes(in, &header, sizeof(header));
+    if (std::memcmp(header.magic, "VPRB", 4) != 0) {
+        throw std::runtime_error("Not a binary graph file.");
+    }
+    if (header.version != BINARY_FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported binary format version.");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Binary file was written with another byte order.");
+    }
+    if (header.kind != static_cast<uint8_t>(kind)) {
+        throw std::runtime_error("Binary file holds another kind of topology.");
+    }
+    if (header.valueEncoding != static_cast<uint8_t>(encoding) || header.valueSize != valueSize) {
+        throw std::runtime_error("Binary file holds values in another encoding.");
+    }
+    return header;
+}
+
+/**
+ * @brief Maps every live node to its rank among the live nodes, removed nodes to -1.
+ */
+template <typename GraphType>
+std::vector<uint64_t> liveRemap(const GraphType& graph, size_t& live) {
+    std::vector<uint64_t> remap(graph.size());
+    live = 0;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        remap[i] = graph.isRemoved(i) ? static_cast<uint64_t>(-1) : live++;
+    }
+    return remap;
+}
+
+template <typename GraphType>
+void writeRawValues(std::ostream& out, const GraphType& graph) {
+    using T = typename GraphType::Node::DataType;
+    static_assert(std::is_trivially_copyable<T>::value, "Values that are not trivially copyable need a serializer.");
+    // Values are gathered in chunks so large graphs are written with few, large writes.
+    const size_t chunk = (size_t(1) << 20) / sizeof(T) + 1;
+    std::vector<char> buffer;
+    buffer.reserve(chunk * sizeof(T));
+    size_t written = 0;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        const char* value = reinterpret_cast<const char*>(&graph.getNode(i).value());
+        buffer.insert(buffer.end(), value, value + sizeof(T));
+        if (buffer.size() >= chunk * sizeof(T)) {
+            writeBytes(out, buffer.data(), buffer.size());
+            written += buffer.size();
+            buffer.clear();
+        }
+    }
+    writeBytes(out, buffer.data(), buffer.size());
+    writePadding(out, written + buffer.size());
+}
+
+template <typename T>
+std::vector<T> readRawValues(std::istream& in, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "Values that are not trivially copyable need a serializer.");
+    std::vector<T> values = readArray<T>(in, count);
+    skipPadding(in, count * sizeof(T));
+    return values;
+}
+
+template <typename GraphType, typename Serializer>
+void writeSerializedValues(std::ostream& out, const GraphType& graph, Serializer& serializer) {
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (!graph.isRemoved(i)) {
+            serializer.write(out, graph.getNode(i).value());
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write binary data.");
+    }
+}
+
+template <typename GraphType>
+void writeTreeTopology(std::ostream& out, const GraphType& tree, ValueEncoding encoding, size_t valueSize) {
+    size_t live = 0;
+    std::vector<uint64_t> remap = liveRemap(tree, live);
+    FileHeader header = makeHeader(TopologyKind::Tree, encoding, valueSize, live, live == 0 ? 0 : live - 1, 0);
+    writeBytes(out, &header, sizeof(header));
+    std::vector<uint64_t> parents;
+    parents.reserve(live);
+    for (size_t i = 0; i < tree.size(); ++i) {
+        if (!tree.isRemoved(i)) {
+            parents.push_back(i == 0 ? 0 : remap[tree.getNode(i).parentId()]);
+        }
+    }
+    writeBytes(out, parents.data(), parents.size() * sizeof(uint64_t));
+}
+
+template <typename GraphType>
+void writeAdjacencyTopology(std::ostream& out, const GraphType& graph, ValueEncoding encoding, size_t valueSize) {
+    size_t live = 0;
+    std::vector<uint64_t> remap = liveRemap(graph, live);
+    std::vector<uint64_t> offsets;
+    offsets.reserve(live + 1);
+    offsets.push_back(0);
+    std::vector<uint64_t> targets;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        for (size_t target : graph.getNode(i).edges()) {
+            if (remap[target] != static_cast<uint64_t>(-1)) {
+                targets.push_back(remap[target]);
+            }
+        }
+        offsets.push_back(targets.size());
+    }
+
+    uint32_t flags = 0;
+    if (graph.isNormalized()) {
+        flags |= FLAG_NORMALIZED;
+    }
+    if (graph.adjacencyMode() == templates::AdjacencyMode::SortedUnique) {
+        flags |= FLAG_SORTED_UNIQUE;
+    }
+    FileHeader header = makeHeader(TopologyKind::Adjacency, encoding, valueSize, live, targets.size(), flags);
+    writeBytes(out, &header, sizeof(header));
+    writeBytes(out, offsets.data(), offsets.size() * sizeof(uint64_t));
+    writeBytes(out, targets.data(), targets.size() * sizeof(uint64_t));
+}
+
+inline std::vector<uint64_t> readTreeTopology(std::istream& in, const FileHeader& header) {
+    std::vector<uint64_t> parents = readArray<uint64_t>(in, header.nodeCount);
+    for (size_t i = 1; i < parents.size(); ++i) {
+        if (parents[i] >= i) {
+            throw std::runtime_error("Invalid parent id in binary tree.");
+        }
+    }
+    return parents;
+}
+
+/**
+ * @brief Builds a tree from its parent ids, pulling values one by one from `nextValue()`.
+ *
+ * Children are appended in index order, and every edge container is reserved to its final
+ * size first so it is allocated once.
+ */
+template <typename TreeType, typename NextValue>
+TreeType buildTree(const std::vector<uint64_t>& parents, NextValue nextValue) {
+    if (parents.empty()) {
+        throw std::runtime_error("Binary tree has no root.");
+    }
+    TreeType tree(nextValue(), parents.size());
+    std::vector<size_t> degrees(parents.size(), 0);
+    for (size_t i = 1; i < parents.size(); ++i) {
+        ++degrees[parents[i]];
+    }
+    tree.getNode(0).reserveEdges(degrees[0]);
+    for (size_t i = 1; i < parents.size(); ++i) {
+        size_t child = tree.addChild(static_cast<size_t>(parents[i]), nextValue());
+        if (degrees[child] != 0) {
+            tree.getNode(child).reserveEdges(degrees[child]);
+        }
+    }
+    return tree;
+}
+
+inline void readAdjacencyTopology(std::istream& in, const FileHeader& header,
+                                  std::vector<uint64_t>& offsets, std::vector<uint64_t>& targets) {
+    if (header.nodeCount == std::numeric_limits<uint64_t>::max()) {
+        throw std::runtime_error("Binary data is truncated.");
+    }
+    offsets = readArray<uint64_t>(in, header.nodeCount + 1);
+    targets = readArray<uint64_t>(in, header.edgeCount);
+}
+
+template <typename GraphType>
+void finishGraph(GraphType& graph, const FileHeader& header,
+                 const std::vector<uint64_t>& offsets, const std::vector<uint64_t>& targets) {
+    try {
+        graph.assignAdjacency(offsets, targets);
+    } catch (const std::logic_error&) {
+        throw std::runtime_error("Invalid adjacency in binary graph.");
+    }
+    if (header.flags & FLAG_SORTED_UNIQUE) {
+        graph.setAdjacencyMode(templates::AdjacencyMode::SortedUnique);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Writes a tree with trivially copyable values in the binary format.
+ *
+ * Removed nodes are skipped and the remaining ones renumbered densely on the fly, as
+ * `compact()` would. Open the stream in binary mode.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ * @param out The output stream.
+ * @param tree The tree to write.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename TreeType>
+void saveTree(std::ostream& out, const TreeType& tree) {
+    using T = typename TreeType::Node::DataType;
+    detail::writeTreeTopology(out, tree, ValueEncoding::Raw, sizeof(T));
+    detail::writeRawValues(out, tree);
+}
+
+/**
+ * @brief Writes a tree in the binary format, values being written by a serializer.
+ *
+ * The serializer provides `void write(std::ostream&, const T&)` and `T read(std::istream&)`.
+ *
+ * @tparam TreeType The type of the tree.
+ * @tparam Serializer The value serializer.
+ * @param out The output stream.
+ * @param tree The tree to write.
+ * @param serializer The value serializer.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename TreeType, typename Serializer>
+void saveTree(std::ostream& out, const TreeType& tree, Serializer serializer) {
+    detail::writeTreeTopology(out, tree, ValueEncoding::Serializer, 0);
+    detail::writeSerializedValues(out, tree, serializer);
+}
+
+/**
+ * @brief Reads a tree with trivially copyable values written by `saveTree`.
+ *
+ * The topology and the values are each read with a single call.
+ *
+ * @tparam TreeType The type of the tree.
+ * @param in The input stream.
+ * @return The tree.
+ * @throw std::runtime_error If the data is truncated or not a compatible binary tree.
+ */
+template <typename TreeType>
+TreeType loadTree(std::istream& in) {
+    using T = typename TreeType::Node::DataType;
+    FileHeader header = detail::readHeader(in, TopologyKind::Tree, ValueEncoding::Raw, sizeof(T));
+    std::vector<uint64_t> parents = detail::readTreeTopology(in, header);
+    std::vector<T> values = detail::readRawValues<T>(in, parents.size());
+    size_t next = 0;
+    return detail::buildTree<TreeType>(parents, [&values, &next]() { return std::move(values[next++]); });
+}
+
+/**
+ * @brief Reads a tree written by `saveTree` with a serializer.
+ *
+ * @tparam TreeType The type of the tree.
+ * @tparam Serializer The value serializer.
+ * @param in The input stream.
+ * @param serializer The value serializer.
+ * @return The tree.
+ * @throw std::runtime_error If the data is truncated or not a compatible binary tree.
+ */
+template <typename TreeType, typename Serializer>
+TreeType loadTree(std::istream& in, Serializer serializer) {
+    FileHeader header = detail::readHeader(in, TopologyKind::Tree, ValueEncoding::Serializer, 0);
+    std::vector<uint64_t> parents = detail::readTreeTopology(in, header);
+    return detail::buildTree<TreeType>(parents, [&in, &serializer]() { return serializer.read(in); });
+}
+
+/**
+ * @brief Writes a graph or digraph with trivially copyable values in the binary format.
+ *
+ * Removed nodes and the edges pointing to them are skipped and the remaining nodes
+ * renumbered densely on the fly, as `compact()` would. Open the stream in binary mode.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @param out The output stream.
+ * @param graph The graph to write.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename GraphType>
+void saveGraph(std::ostream& out, const GraphType& graph) {
+    using T = typename GraphType::Node::DataType;
+    detail::writeAdjacencyTopology(out, graph, ValueEncoding::Raw, sizeof(T));
+    detail::writeRawValues(out, graph);
+}
+
+/**
+ * @brief Writes a graph or digraph in the binary format, values being written by a serializer.
+ *
+ * @tparam GraphType The type of the graph.
+ * @tparam Serializer The value serializer, see `saveTree`.
+ * @param out The output stream.
+ * @param graph The graph to write.
+ * @param serializer The value serializer.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename GraphType, typename Serializer>
+void saveGraph(std::ostream& out, const GraphType& graph, Serializer serializer) {
+    detail::writeAdjacencyTopology(out, graph, ValueEncoding::Serializer, 0);
+    detail::writeSerializedValues(out, graph, serializer);
+}
+
+/**
+ * @brief Reads a graph or digraph with trivially copyable values written by `saveGraph`.
+ *
+ * The offsets, the targets and the values are each read with a single call, and every
+ * edge container is allocated once at its final size.
+ *
+ * @tparam GraphType The type of the graph.
+ * @param in The input stream.
+ * @return The graph.
+ * @throw std::runtime_error If the data is truncated or not a compatible binary graph.
+ */
+template <typename GraphType>
+GraphType loadGraph(std::istream& in) {
+    using T = typename GraphType::Node::DataType;
+    FileHeader header = detail::readHeader(in, TopologyKind::Adjacency, ValueEncoding::Raw, sizeof(T));
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> targets;
+    detail::readAdjacencyTopology(in, header, offsets, targets);
+    std::vector<T> values = detail::readRawValues<T>(in, header.nodeCount);
+
+    GraphType graph;
+    graph.reserve(values.size());
+    for (T& value : values) {
+        graph.emplace_node(std::move(value));
+    }
+    detail::finishGraph(graph, header, offsets, targets);
+    return graph;
+}
+
+/**
+ * @brief Reads a graph or digraph written by `saveGraph` with a serializer.
+ *
+ * @tparam GraphType The type of the graph.
+ * @tparam Serializer The value serializer.
+ * @param in The input stream.
+ * @param serializer The value serializer.
+ * @return The graph.
+ * @throw std::runtime_error If the data is truncated or not a compatible binary graph.
+ */
+template <typename GraphType, typename Serializer>
+GraphType loadGraph(std::istream& in, Serializer serializer) {
+    FileHeader header = detail::readHeader(in, TopologyKind::Adjacency, ValueEncoding::Serializer, 0);
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> targets;
+    detail::readAdjacencyTopology(in, header, offsets, targets);
+
+    // The offsets have been read, so the node count is bounded by the size of the data.
+    GraphType graph;
+    graph.reserve(offsets.size() - 1);
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        graph.emplace_node(serializer.read(in));
+    }
+    detail::finishGraph(graph, header, offsets, targets);
+    return graph;
+}
+
+} // namespace io
+} // namespace vpr
+
+#endif // BINARY_FORMAT_HPP
@@ -0,0 +1,128 @@
+#ifndef BUFFERED_WRITER_HPP
+#define BUFFERED_WRITER_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Output buffer in front of a stream, with allocation-free number formatting.
+ *
+ * Bytes are collected in a fixed-size buffer and handed to the stream in large blocks, which
+ * avoids the per-call overhead of `operator<<` and the locale machinery. The buffer is
+ * flushed when full, by `flush()` and on destruction.
+ */
+class BufferedWriter {
+
+    std::ostream& out_;        ///< Destination stream.
+    std::vector<char> buffer_; ///< Pending bytes, `capacity()` is the flush threshold.
+    size_t used_ = 0;          ///< Number of pending bytes.
+
+public:
+
+    /**
+     * @brief Constructs a writer.
+     *
+     * @param out The destination stream, opened in binary mode for exact output.
+     * @param capacity The size of the buffer in bytes.
+     */
+    explicit BufferedWriter(std::ostream& out, size_t capacity = size_t(1) << 16)
+        : out_(out), buffer_(capacity > 64 ? capacity : 64) {}
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    /**
+     * @brief Flushes the pending bytes, ignoring errors. Call `flush()` to observe them.
+     */
+    ~BufferedWriter() {
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+
+    /**
+     * @brief Hands the pending bytes to the stream.
+     *
+     * @throw std::runtime_error If the stream fails.
+     */
+    void flush() {
+        if (used_ != 0) {
+            out_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+            used_ = 0;
+            if (!out_) {
+                throw std::runtime_error("Failed to write output.");
+            }
+        }
+    }
+
+    inline void put(char c) {
+        if (used_ == buffer_.size()) {
+            flush();
+        }
+        buffer_[used_++] = c;
+    }
+
+    void write(const char* data, size_t size) {
+        if (size > buffer_.size() - used_) {
+            flush();
+            if (size > buffer_.size()) {
+                out_.write(data, static_cast<std::streamsize>(size));
+                if (!out_) {
+                    throw std::runtime_error("Failed to write output.");
+                }
+                return;
+            }
+        }
+        std::memcpy(buffer_.data() + used_, data, size);
+        used_ += size;
+    }
+
+    inline void write(const char* text) { write(text, std::strlen(text)); }
+    inline void write(const std::string& text) { write(text.data(), text.size()); }
+
+    void writeUnsigned(uint64_t value) {
+        char digits[20];
+        size_t n = 0;
+        do {
+            digits[sizeof(digits) - ++n] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        write(digits + sizeof(digits) - n, n);
+    }
+
+    void writeInteger(int64_t value) {
+        if (value < 0) {
+            put('-');
+            writeUnsigned(0 - static_cast<uint64_t>(value));
+        } else {
+            writeUnsigned(static_cast<uint64_t>(value));
+        }
+    }
+
+    /**
+     * @brief Writes the shortest of the 15 and 17 significant digit forms that reads back exactly.
+     */
+    void writeNumber(double value) {
+        char text[32];
+        int n = std::snprintf(text, sizeof(text), "%.15g", value);
+        if (std::strtod(text, nullptr) != value) {
+            n = std::snprintf(text, sizeof(text), "%.17g", value);
+        }
+        write(text, static_cast<size_t>(n));
+    }
+};
+
+} // namespace io
+} // namespace vpr
+
+#endif // BUFFERED_WRITER_HPP
@@ -0,0 +1,308 @@
+#ifndef EDGE_LIST_HPP
+#define EDGE_LIST_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "atomic_bitmap.hpp"
+#include "graph_kind.hpp"
+#include "mapped_view.hpp"
+#include "work_stealing.hpp"
+
+namespace vpr {
+namespace io {
+namespace detail {
+
+/**
+ * @brief Edges parsed by one worker, as consecutive (source, target) pairs of raw ids.
+ */
+struct ParsedEdges {
+    std::vector<uint64_t> ids;  ///< Raw ids, two per edge.
+    uint64_t maxId = 0;         ///< Largest id seen.
+    std::exception_ptr error;   ///< Parse error raised by the worker, if any.
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == ','; }
+
+/**
+ * @brief Parses an unsigned decimal integer, advancing the cursor past it.
+ *
+ * @return `false` if the cursor is not on a digit or the number does not fit in 64 bits.
+ */
+inline bool parseId(const char*& p, const char* end, uint64_t& value) {
+    if (p == end || static_cast<unsigned>(*p - '0') > 9) {
+        return false;
+    }
+    uint64_t result = 0;
+    do {
+        const unsigned digit = static_cast<unsigned>(*p - '0');
+        if (result > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+        ++p;
+    } while (p != end && static_cast<unsigned>(*p - '0') <= 9);
+    value = result;
+    return true;
+}
+
+inline const char* skipLine(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline == nullptr ? end : static_cast<const char*>(newline) + 1;
+}
+
+/**
+ * @brief Returns the offset of the first edge line, past a Matrix Market banner and size line.
+ */
+inline size_t dataStart(const char* data, size_t size) {
+    const char* p = data;
+    const char* end = data + size;
+    const bool matrixMarket = size >= 14 && std::memcmp(data, "%%MatrixMarket", 14) == 0;
+    if (!matrixMarket) {
+        return 0;
+    }
+    while (p != end) {
+        const char* line = p;
+        while (line != end && isBlank(*line)) {
+            ++line;
+        }
+        p = skipLine(p, end);
+        if (line != end && *line != '%' && *line != '\n') {
+            break; // The size line.
+        }
+    }
+    return static_cast<size_t>(p - data);
+}
+
+/**
+ * @brief Parses every line starting in `[begin, end)`, reading past `end` to finish the last one.
+ */
+inline void parseEdgeLines(const char* begin, const char* end, const char* limit, ParsedEdges& edges) {
+    const char* p = begin;
+    while (p < end) {
+        while (p != limit && isBlank(*p)) {
+            ++p;
+        }
+        if (p == limit) {
+            break;
+        }
+        if (*p == '\n') {
+            ++p;
+            continue;
+        }
+        if (*p == '#' || *p == '%') {
+            p = skipLine(p, limit);
+            continue;
+        }
+        uint64_t from = 0;
+        uint64_t to = 0;
+        const char* line = p;
+        bool ok = parseId(p, limit, from);
+        if (ok) {
+            while (p != limit && isBlank(*p)) {
+                ++p;
+            }
+            ok = parseId(p, limit, to);
+        }
+        if (!ok) {
+            throw std::runtime_error("Malformed edge list line: " + std::string(line, skipLine(line, limit)));
+        }
+        edges.ids.push_back(from);
+        edges.ids.push_back(to);
+        edges.maxId = std::max(edges.maxId, std::max(from, to));
+        p = skipLine(p, limit);
+    }
+}
+
+/**
+ * @brief Splits the text in byte ranges and parses them on a team of threads.
+ */
+inline std::vector<ParsedEdges> parseEdgeList(const char* data, size_t size, size_t nThreads) {
+    const size_t start = dataStart(data, size);
+    const size_t length = size - start;
+    const size_t minChunk = size_t(1) << 20;
+    nThreads = std::max<size_t>(1, std::min(nThreads, length / minChunk + 1));
+
+    std::vector<ParsedEdges> parsed(nThreads);
+    const char* first = data + start;
+    const char* limit = data + size;
+    parallel::runTeam(nThreads, [&](size_t worker) {
+        // A worker owns the lines starting in its range.
+        const char* begin = first + length * worker / nThreads;
+        const char* end = first + length * (worker + 1) / nThreads;
+        if (begin != first && begin[-1] != '\n') {
+            begin = std::min(skipLine(begin, limit), end);
+        }
+        ParsedEdges& edges = parsed[worker];
+        edges.ids.reserve(static_cast<size_t>(end - begin) / 6);
+        try {
+            parseEdgeLines(begin, end, limit, edges);
+        } catch (...) {
+            edges.error = std::current_exception();
+        }
+    });
+    for (const ParsedEdges& edges : parsed) {
+        if (edges.error) {
+            std::rethrow_exception(edges.error);
+        }
+    }
+    return parsed;
+}
+
+/**
+ * @brief Maps raw ids to dense indices, keeping their relative order.
+ *
+ * Ids that are already dense (every id from 0 to the largest one appears) are kept as is.
+ */
+inline std::vector<uint64_t> denseIds(std::vector<ParsedEdges>& parsed) {
+    uint64_t maxId = 0;
+    size_t endpoints = 0;
+    for (const ParsedEdges& edges : parsed) {
+        maxId = std::max(maxId, edges.maxId);
+        endpoints += edges.ids.size();
+    }
+    if (endpoints == 0) {
+        return std::vector<uint64_t>();
+    }
+
+    std::vector<uint64_t> originalIds;
+    if (maxId < 4 * static_cast<uint64_t>(endpoints)) {
+        // Small id space: mark the ids present, then number them in increasing order.
+        parallel::AtomicBitmap present(static_cast<size_t>(maxId) + 1);
+        parallel::runTeam(parsed.size(), [&](size_t worker) {
+            for (uint64_t id : parsed[worker].ids) {
+                present.claim(static_cast<size_t>(id));
+            }
+        });
+        std::vector<uint64_t> index(static_cast<size_t>(maxId) + 1, static_cast<uint64_t>(-1));
+        for (size_t id = 0; id <= maxId; ++id) {
+            if (present.test(id)) {
+                index[id] = originalIds.size();
+                originalIds.push_back(id);
+            }
+        }
+        if (originalIds.size() != index.size()) {
+            parallel::runTeam(parsed.size(), [&](size_t worker) {
+                for (uint64_t& id : parsed[worker].ids) {
+                    id = index[static_cast<size_t>(id)];
+                }
+            });
+        }
+    } else {
+        // Sparse id space: sort the distinct ids and binary search them.
+        for (const ParsedEdges& edges : parsed) {
+            originalIds.insert(originalIds.end(), edges.ids.begin(), edges.ids.end());
+        }
+        std::sort(originalIds.begin(), originalIds.end());
+        originalIds.erase(std::unique(originalIds.begin(), originalIds.end()), originalIds.end());
+        parallel::runTeam(parsed.size(), [&](size_t worker) {
+            for (uint64_t& id : parsed[worker].ids) {
+                id = static_cast<uint64_t>(std::lower_bound(originalIds.begin(), originalIds.end(), id) - originalIds.begin());
+            }
+        });
+    }
+    return originalIds;
+}
+
+/**
+ * @brief Builds the CSR adjacency of the parsed edges and assigns it to the graph.
+ *
+ * Edges keep the order of the file. Undirected edges are stored from both ends, self-loops once.
+ */
+template <typename Index, typename GraphType>
+void assignParsedEdges(GraphType& graph, const std::vector<ParsedEdges>& parsed, bool undirected) {
+    const size_t n = graph.size();
+    std::vector<Index> offsets(n + 1, 0);
+    for (const ParsedEdges& edges : parsed) {
+        for (size_t e = 0; e < edges.ids.size(); e += 2) {
+            ++offsets[edges.ids[e] + 1];
+            if (undirected && edges.ids[e] != edges.ids[e + 1]) {
+                ++offsets[edges.ids[e + 1] + 1];
+            }
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<Index> targets(static_cast<size_t>(offsets[n]));
+    std::vector<Index> cursor(offsets.begin(), offsets.end() - 1);
+    for (const ParsedEdges& edges : parsed) {
+        for (size_t e = 0; e < edges.ids.size(); e += 2) {
+            const size_t from = static_cast<size_t>(edges.ids[e]);
+            const size_t to = static_cast<size_t>(edges.ids[e + 1]);
+            targets[cursor[from]++] = static_cast<Index>(to);
+            if (undirected && from != to) {
+                targets[cursor[to]++] = static_cast<Index>(from);
+            }
+        }
+    }
+    graph.assignAdjacency(offsets, targets);
+}
+
+} // namespace detail
+
+/**
+ * @brief Loads a graph from a text edge list, such as SNAP or Matrix Market files.
+ *
+ * Each line holds a source and a target id separated by blanks, tabs or a comma; further
+ * columns such as weights are ignored. Lines starting with `#` or `%` are comments, and the
+ * size line following a `%%MatrixMarket` banner is skipped. The file is mapped in memory and
+ * split in byte ranges parsed by `nThreads` threads, then the adjacency is built in a single
+ * bulk assignment instead of one `addEdge` per line.
+ *
+ * Ids that are not dense (or, as in Matrix Market, start at 1) are renumbered to
+ * `0 .. n - 1` in increasing order; `originalIds[i]` receives the id of node `i`. Ids that
+ * never appear in an edge do not produce a node. Nodes hold default-constructed values.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ *         Graphs for which `IsUndirected` holds store every edge from both ends.
+ * @param path The path of the file.
+ * @param originalIds Receives the original id of every node.
+ * @param nThreads Number of parsing threads, including the calling thread.
+ * @return The loaded graph.
+ * @throw std::system_error If the file cannot be mapped.
+ * @throw std::runtime_error If a line is malformed.
+ */
+template <typename GraphType>
+GraphType loadEdgeList(const std::string& path, std::vector<uint64_t>& originalIds,
+                       size_t nThreads = parallel::hardwareConcurrency()) {
+    MappedFile file(path);
+    std::vector<detail::ParsedEdges> parsed = detail::parseEdgeList(file.data(), file.size(), nThreads);
+    originalIds = detail::denseIds(parsed);
+
+    GraphType graph;
+    graph.reserve(originalIds.size());
+    for (size_t i = 0; i < originalIds.size(); ++i) {
+        graph.emplace_node(typename GraphType::Node::DataType());
+    }
+    size_t edges = 0;
+    for (const detail::ParsedEdges& part : parsed) {
+        edges += part.ids.size();
+    }
+    if (originalIds.size() <= UINT32_MAX && edges <= UINT32_MAX) {
+        detail::assignParsedEdges<uint32_t>(graph, parsed, IsUndirected<GraphType>::value);
+    } else {
+        detail::assignParsedEdges<uint64_t>(graph, parsed, IsUndirected<GraphType>::value);
+    }
+    return graph;
+}
+
+/**
+ * @brief Loads a graph from a text edge list, discarding the original ids.
+ *
+ * See the overload taking `originalIds`.
+ */
+template <typename GraphType>
+GraphType loadEdgeList(const std::string& path, size_t nThreads = parallel::hardwareConcurrency()) {
+    std::vector<uint64_t> originalIds;
+    return loadEdgeList<GraphType>(path, originalIds, nThreads);
+}
+
+} // namespace io
+} // namespace vpr
+
+#endif // EDGE_LIST_HPP
@@ -0,0 +1,265 @@
+#ifndef FLAT_LAYOUT_HPP
+#define FLAT_LAYOUT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "binary_format.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Read-only contiguous range of edge targets stored in a flat file.
+ */
+class EdgeSpan {
+
+    const uint64_t* begin_; ///< First target.
+    const uint64_t* end_;   ///< One past the last target.
+
+public:
+    using value_type = uint64_t;
+    using const_iterator = const uint64_t*;
+    using const_reverse_iterator = std::reverse_iterator<const uint64_t*>;
+
+    EdgeSpan(const uint64_t* begin, const uint64_t* end) : begin_(begin), end_(end) {}
+
+    const_iterator begin() const noexcept { return begin_; }
+    const_iterator end() const noexcept { return end_; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end_); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin_); }
+    size_t size() const noexcept { return static_cast<size_t>(end_ - begin_); }
+    bool empty() const noexcept { return begin_ == end_; }
+    uint64_t front() const { return *begin_; }
+    uint64_t back() const { return *(end_ - 1); }
+    uint64_t operator[](size_t i) const { return begin_[i]; }
+};
+
+/**
+ * @brief Node record of the flat on-disk layout, used in place over mapped memory.
+ *
+ * A record only holds fixed-size fields: the edges live in a shared target array and are
+ * found through a byte offset relative to the record itself, so records stay valid wherever
+ * the file is mapped. The interface mirrors `lightweight::tree::Node`.
+ *
+ * @tparam T The type of the value, which must be trivially copyable.
+ */
+template <typename T>
+class FlatNode {
+    static_assert(std::is_trivially_copyable<T>::value, "Flat files can only hold trivially copyable values.");
+
+    uint64_t index_;       ///< Index of the node.
+    uint64_t parent_id_;   ///< Index of the parent node, the node itself for graphs and the root.
+    int64_t edges_offset_; ///< Byte offset of the first edge target, relative to this record.
+    uint64_t degree_;      ///< Number of edges.
+    uint64_t child_index_; ///< Position of the node among the children of its parent.
+    T value_;              ///< Value stored in the node.
+
+public:
+    using DataType = T;
+
+    /**
+     * @brief Constructs a record, used by the writers.
+     */
+    FlatNode(uint64_t index, uint64_t parent_id, int64_t edges_offset, uint64_t degree,
+             uint64_t child_index, const T& value)
+        : index_(index), parent_id_(parent_id), edges_offset_(edges_offset), degree_(degree),
+          child_index_(child_index), value_(value) {}
+
+    inline size_t index() const noexcept { return static_cast<size_t>(index_); }
+    inline size_t parentId() const noexcept { return static_cast<size_t>(parent_id_); }
+    inline size_t childIndex() const noexcept { return static_cast<size_t>(child_index_); }
+    inline size_t degree() const noexcept { return static_cast<size_t>(degree_); }
+    inline size_t nChildren() const noexcept { return degree(); }
+    inline bool isolated() const noexcept { return degree_ == 0; }
+    inline bool isLeaf() const noexcept { return degree_ == 0; }
+    inline bool isRoot() const noexcept { return index_ == 0; }
+
+    const T& value() const noexcept { return value_; }
+    const T& operator*() const noexcept { return value_; }
+    const T* operator->() const noexcept { return &value_; }
+
+    /**
+     * @brief Returns the edge targets of the node.
+     *
+     * @return A range over the targets, stored next to the other records' targets.
+     */
+    EdgeSpan edges() const noexcept {
+        const uint64_t* first = reinterpret_cast<const uint64_t*>(reinterpret_cast<const char*>(this) + edges_offset_);
+        return EdgeSpan(first, first + degree_);
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Byte offsets of the sections of a flat file.
+ */
+struct FlatLayout {
+    size_t records; ///< Offset of the node records.
+    size_t targets; ///< Offset of the edge target array.
+    size_t size;    ///< Total size of the file.
+};
+
+inline size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Computes the layout of a flat file, the counts possibly coming from an untrusted header.
+ *
+ * @throw std::runtime_error If the sizes overflow, which no complete file can match.
+ */
+template <typename T>
+FlatLayout flatLayout(uint64_t nodeCount, uint64_t edgeCount) {
+    const size_t alignment = alignof(FlatNode<T>) > 8 ? alignof(FlatNode<T>) : 8;
+    FlatLayout layout;
+    layout.records = roundUp(sizeof(FileHeader), alignment);
+    // The 7 extra bytes make room for rounding the end of the records up to 8 bytes.
+    size_t recordsEnd = 0;
+    if (!checkedSize(nodeCount, sizeof(FlatNode<T>), layout.records + 7, recordsEnd)) {
+        throw std::runtime_error("Flat file is truncated.");
+    }
+    layout.targets = recordsEnd / 8 * 8;
+    if (!checkedSize(edgeCount, sizeof(uint64_t), layout.targets, layout.size)) {
+        throw std::runtime_error("Flat file is truncated.");
+    }
+    return layout;
+}
+
+/**
+ * @brief Parent and child position of tree nodes, taken from `parentId()` and the edges.
+ */
+struct TreeLinks {
+    template <typename GraphType>
+    static void compute(const GraphType& tree, const std::vector<uint64_t>& remap,
+                        std::vector<uint64_t>& parents, std::vector<uint64_t>& childIndices) {
+        for (size_t i = 0; i < tree.size(); ++i) {
+            if (tree.isRemoved(i)) {
+                continue;
+            }
+            parents[remap[i]] = i == 0 ? 0 : remap[tree.getNode(i).parentId()];
+            size_t position = 0;
+            for (size_t child : tree.getNode(i).edges()) {
+                childIndices[remap[child]] = position++;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Graph nodes are their own parent and have no child position.
+ */
+struct GraphLinks {
+    template <typename GraphType>
+    static void compute(const GraphType&, const std::vector<uint64_t>&,
+                        std::vector<uint64_t>& parents, std::vector<uint64_t>&) {
+        for (size_t i = 0; i < parents.size(); ++i) {
+            parents[i] = i;
+        }
+    }
+};
+
+template <typename Links, typename GraphType>
+void writeFlat(std::ostream& out, const GraphType& graph, TopologyKind kind) {
+    using T = typename GraphType::Node::DataType;
+    using Record = FlatNode<T>;
+
+    size_t live = 0;
+    std::vector<uint64_t> remap = liveRemap(graph, live);
+    std::vector<uint64_t> offsets;
+    offsets.reserve(live + 1);
+    offsets.push_back(0);
+    std::vector<uint64_t> targets;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        for (size_t target : graph.getNode(i).edges()) {
+            if (remap[target] != static_cast<uint64_t>(-1)) {
+                targets.push_back(remap[target]);
+            }
+        }
+        offsets.push_back(targets.size());
+    }
+    std::vector<uint64_t> parents(live, 0);
+    std::vector<uint64_t> childIndices(live, 0);
+    Links::compute(graph, remap, parents, childIndices);
+
+    const FlatLayout layout = flatLayout<T>(live, targets.size());
+    const uint32_t flags = graph.isNormalized() ? FLAG_NORMALIZED : 0;
+    FileHeader header = makeHeader(kind, ValueEncoding::Raw, sizeof(T), live, targets.size(), flags);
+    writeBytes(out, &header, sizeof(header));
+    writePadding(out, sizeof(header));
+    std::vector<char> zeros(layout.records - roundUp(sizeof(header), 8), 0);
+    writeBytes(out, zeros.data(), zeros.size());
+
+    // Records are built in a zeroed buffer, so padding bytes are deterministic.
+    const size_t chunk = 4096;
+    std::vector<char> buffer;
+    size_t k = 0;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        if (buffer.empty()) {
+            buffer.assign(std::min(chunk, live - k) * sizeof(Record), 0);
+        }
+        const size_t slot = k % chunk;
+        const int64_t edgesOffset = static_cast<int64_t>(layout.targets + offsets[k] * sizeof(uint64_t))
+                                  - static_cast<int64_t>(layout.records + k * sizeof(Record));
+        new (buffer.data() + slot * sizeof(Record))
+            Record(k, parents[k], edgesOffset, offsets[k + 1] - offsets[k], childIndices[k], graph.getNode(i).value());
+        ++k;
+        if (slot + 1 == buffer.size() / sizeof(Record)) {
+            writeBytes(out, buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    writePadding(out, layout.records + live * sizeof(Record));
+    writeBytes(out, targets.data(), targets.size() * sizeof(uint64_t));
+}
+
+} // namespace detail
+
+/**
+ * @brief Writes a tree in the flat layout read by `MappedTree`.
+ *
+ * The file holds the `FileHeader`, then one `FlatNode` record per live node, then every
+ * child list back to back. Removed nodes are skipped and the others renumbered densely.
+ * Values must be trivially copyable. Open the stream in binary mode.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ * @param out The output stream.
+ * @param tree The tree to write.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename TreeType>
+void saveFlatTree(std::ostream& out, const TreeType& tree) {
+    detail::writeFlat<detail::TreeLinks>(out, tree, TopologyKind::FlatTree);
+}
+
+/**
+ * @brief Writes a graph or digraph in the flat layout read by `MappedGraph`.
+ *
+ * See `saveFlatTree`. Edges to removed nodes are dropped.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @param out The output stream.
+ * @param graph The graph to write.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename GraphType>
+void saveFlatGraph(std::ostream& out, const GraphType& graph) {
+    detail::writeFlat<detail::GraphLinks>(out, graph, TopologyKind::FlatAdjacency);
+}
+
+} // namespace io
+} // namespace vpr
+
+#endif // FLAT_LAYOUT_HPP
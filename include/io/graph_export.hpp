@@ -0,0 +1,267 @@
+#ifndef GRAPH_EXPORT_HPP
+#define GRAPH_EXPORT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include "buffered_writer.hpp"
+#include "graph_kind.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Escaping rules applied to formatted values.
+ */
+enum class Escape {
+    Dot, ///< Inside a double-quoted DOT string.
+    Xml  ///< Inside XML character data.
+};
+
+/**
+ * @brief Destination of a value formatter, escaping text for the output format.
+ *
+ * Formatters write straight into the exporter's buffer, so no string is built per node.
+ */
+class ValueSink {
+
+    BufferedWriter& writer_; ///< Underlying writer.
+    Escape escape_;          ///< Escaping applied to text.
+
+public:
+    ValueSink(BufferedWriter& writer, Escape escape) : writer_(writer), escape_(escape) {}
+
+    void write(const char* text, size_t size) {
+        const char* run = text;
+        const char* end = text + size;
+        for (const char* p = text; p != end; ++p) {
+            const char* replacement = escaped(*p);
+            if (replacement != nullptr) {
+                writer_.write(run, static_cast<size_t>(p - run));
+                writer_.write(replacement);
+                run = p + 1;
+            }
+        }
+        writer_.write(run, static_cast<size_t>(end - run));
+    }
+
+    inline void write(const char* text) { write(text, std::strlen(text)); }
+    inline void write(const std::string& text) { write(text.data(), text.size()); }
+    inline void put(char c) { write(&c, 1); }
+
+    inline void writeUnsigned(uint64_t value) { writer_.writeUnsigned(value); }
+    inline void writeInteger(int64_t value) { writer_.writeInteger(value); }
+    inline void writeNumber(double value) { writer_.writeNumber(value); }
+
+private:
+
+    const char* escaped(char c) const {
+        switch (c) {
+        case '"': return escape_ == Escape::Dot ? "\\\"" : "&quot;";
+        case '\\': return escape_ == Escape::Dot ? "\\\\" : nullptr;
+        case '\n': return escape_ == Escape::Dot ? "\\n" : nullptr;
+        case '&': return escape_ == Escape::Xml ? "&amp;" : nullptr;
+        case '<': return escape_ == Escape::Xml ? "&lt;" : nullptr;
+        case '>': return escape_ == Escape::Xml ? "&gt;" : nullptr;
+        default: return nullptr;
+        }
+    }
+};
+
+/**
+ * @brief Default value formatter, handling arithmetic values and strings.
+ *
+ * Other value types need a callable `void(ValueSink&, const T&)`.
+ */
+struct FormatValue {
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    operator()(ValueSink& sink, T value) const { sink.writeInteger(static_cast<int64_t>(value)); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    operator()(ValueSink& sink, T value) const { sink.writeUnsigned(static_cast<uint64_t>(value)); }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    operator()(ValueSink& sink, T value) const { sink.writeNumber(static_cast<double>(value)); }
+
+    void operator()(ValueSink& sink, const std::string& value) const { sink.write(value); }
+    void operator()(ValueSink& sink, const char* value) const { sink.write(value); }
+};
+
+/**
+ * @brief Formatter exporting the structure only, without labels or data.
+ */
+struct NoValues {
+    template <typename T>
+    void operator()(ValueSink&, const T&) const {}
+};
+
+namespace detail {
+
+template <typename Formatter>
+struct WritesValues : std::integral_constant<bool, !std::is_same<Formatter, NoValues>::value> {};
+
+/**
+ * @brief Calls `fn(from, to)` for every edge between live nodes, once per undirected edge.
+ */
+template <typename GraphType, typename Fn>
+void forEachExportedEdge(const GraphType& graph, bool undirected, Fn fn) {
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        for (size_t target : graph.getNode(i).edges()) {
+            if ((!undirected || i <= target) && !graph.isRemoved(target)) {
+                fn(i, static_cast<size_t>(target));
+            }
+        }
+    }
+}
+
+template <typename GraphType, typename Formatter>
+void writeDot(std::ostream& out, const GraphType& graph, bool undirected, Formatter& format) {
+    BufferedWriter writer(out);
+    ValueSink sink(writer, Escape::Dot);
+    writer.write(undirected ? "graph {\n" : "digraph {\n");
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        writer.write("  ", 2);
+        writer.writeUnsigned(i);
+        if (WritesValues<Formatter>::value) {
+            writer.write(" [label=\"", 9);
+            format(sink, graph.getNode(i).value());
+            writer.write("\"]", 2);
+        }
+        writer.write(";\n", 2);
+    }
+    const char* arrow = undirected ? " -- " : " -> ";
+    forEachExportedEdge(graph, undirected, [&](size_t from, size_t to) {
+        writer.write("  ", 2);
+        writer.writeUnsigned(from);
+        writer.write(arrow, 4);
+        writer.writeUnsigned(to);
+        writer.write(";\n", 2);
+    });
+    writer.write("}\n", 2);
+    writer.flush();
+}
+
+template <typename GraphType, typename Formatter>
+void writeGraphML(std::ostream& out, const GraphType& graph, bool undirected, Formatter& format) {
+    BufferedWriter writer(out);
+    ValueSink sink(writer, Escape::Xml);
+    writer.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n");
+    if (WritesValues<Formatter>::value) {
+        writer.write("  <key id=\"value\" for=\"node\" attr.name=\"value\" attr.type=\"string\"/>\n");
+    }
+    writer.write(undirected ? "  <graph id=\"G\" edgedefault=\"undirected\">\n"
+                            : "  <graph id=\"G\" edgedefault=\"directed\">\n");
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (graph.isRemoved(i)) {
+            continue;
+        }
+        writer.write("    <node id=\"n", 15);
+        writer.writeUnsigned(i);
+        if (WritesValues<Formatter>::value) {
+            writer.write("\"><data key=\"value\">", 20);
+            format(sink, graph.getNode(i).value());
+            writer.write("</data></node>\n", 15);
+        } else {
+            writer.write("\"/>\n", 4);
+        }
+    }
+    forEachExportedEdge(graph, undirected, [&](size_t from, size_t to) {
+        writer.write("    <edge source=\"n", 19);
+        writer.writeUnsigned(from);
+        writer.write("\" target=\"n", 11);
+        writer.writeUnsigned(to);
+        writer.write("\"/>\n", 4);
+    });
+    writer.write("  </graph>\n</graphml>\n");
+    writer.flush();
+}
+
+} // namespace detail
+
+/**
+ * @brief Writes a tree in the Graphviz DOT format, as a digraph from parents to children.
+ *
+ * Nodes keep their indices as DOT ids and removed nodes are skipped. Output goes through a
+ * `BufferedWriter`, and values are written by `format` directly into the buffer.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ * @tparam Formatter Callable `void(ValueSink&, const T&)`; `NoValues` omits the labels.
+ * @param out The output stream.
+ * @param tree The tree to write.
+ * @param format The value formatter.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename TreeType, typename Formatter = FormatValue>
+void saveTreeDot(std::ostream& out, const TreeType& tree, Formatter format = Formatter()) {
+    detail::writeDot(out, tree, false, format);
+}
+
+/**
+ * @brief Writes a graph or digraph in the Graphviz DOT format.
+ *
+ * Graphs for which `IsUndirected` holds are written as `graph` with each edge listed once.
+ * See `saveTreeDot`.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @tparam Formatter Callable `void(ValueSink&, const T&)`; `NoValues` omits the labels.
+ * @param out The output stream.
+ * @param graph The graph to write.
+ * @param format The value formatter.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename GraphType, typename Formatter = FormatValue>
+void saveGraphDot(std::ostream& out, const GraphType& graph, Formatter format = Formatter()) {
+    detail::writeDot(out, graph, IsUndirected<GraphType>::value, format);
+}
+
+/**
+ * @brief Writes a tree in the GraphML format, as a directed graph from parents to children.
+ *
+ * Node `i` gets the id `n<i>` and its value, when formatted, is stored in a `value` data key.
+ * See `saveTreeDot`.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ * @tparam Formatter Callable `void(ValueSink&, const T&)`; `NoValues` omits the data.
+ * @param out The output stream.
+ * @param tree The tree to write.
+ * @param format The value formatter.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename TreeType, typename Formatter = FormatValue>
+void saveTreeGraphML(std::ostream& out, const TreeType& tree, Formatter format = Formatter()) {
+    detail::writeGraphML(out, tree, false, format);
+}
+
+/**
+ * @brief Writes a graph or digraph in the GraphML format.
+ *
+ * See `saveTreeGraphML` and `saveGraphDot`.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @tparam Formatter Callable `void(ValueSink&, const T&)`; `NoValues` omits the data.
+ * @param out The output stream.
+ * @param graph The graph to write.
+ * @param format The value formatter.
+ * @throw std::runtime_error If writing fails.
+ */
+template <typename GraphType, typename Formatter = FormatValue>
+void saveGraphGraphML(std::ostream& out, const GraphType& graph, Formatter format = Formatter()) {
+    detail::writeGraphML(out, graph, IsUndirected<GraphType>::value, format);
+}
+
+} // namespace io
+} // namespace vpr
+
+#endif // GRAPH_EXPORT_HPP
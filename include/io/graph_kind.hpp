@@ -0,0 +1,25 @@
+#ifndef GRAPH_KIND_HPP
+#define GRAPH_KIND_HPP
+
+#include <type_traits>
+#include "lightweight_graph.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Tells whether a graph type stores every edge in both directions.
+ *
+ * `lightweight::Graph` is undirected; other graph types are handled as directed.
+ * Specialize it for custom undirected graph types.
+ */
+template <typename GraphType>
+struct IsUndirected : std::false_type {};
+
+template <typename T>
+struct IsUndirected<lightweight::Graph<T>> : std::true_type {};
+
+} // namespace io
+} // namespace vpr
+
+#endif // GRAPH_KIND_HPP
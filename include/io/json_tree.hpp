@@ -0,0 +1,486 @@
+#ifndef JSON_TREE_HPP
+#define JSON_TREE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "lightweight_tree.hpp"
+#include "mapped_view.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Kind of a JSON value.
+ */
+enum class JsonType : uint8_t { Null, Boolean, Number, String, Array, Object };
+
+/**
+ * @brief Value of a tree node built from a JSON document.
+ *
+ * Objects and arrays are nodes whose children are their members and items, in document order.
+ */
+struct JsonNode {
+    JsonType type = JsonType::Null; ///< Kind of the value.
+    bool boolean = false;           ///< Value of booleans.
+    double number = 0;              ///< Value of numbers.
+    std::string text;               ///< Value of strings.
+    std::string key;                ///< Member name when the parent is an object, otherwise empty.
+
+    JsonNode() = default;
+    explicit JsonNode(JsonType t) : type(t) {}
+};
+
+namespace detail {
+
+/**
+ * @brief Iterative JSON parser forwarding SAX events to a handler. See `parseJson`.
+ */
+template <typename Handler>
+class JsonParser {
+
+    const char* begin_;       ///< Start of the input.
+    const char* p_;           ///< Current position.
+    const char* end_;         ///< End of the input.
+    Handler& handler_;        ///< Receiver of the events.
+    std::vector<char> open_;  ///< Open containers, `{` or `[`.
+    std::string scratch_;     ///< Decoded string, reused between strings.
+    std::string number_;      ///< Number text handed to `strtod`, reused between numbers.
+
+public:
+    JsonParser(const char* data, size_t size, Handler& handler)
+        : begin_(data), p_(data), end_(data + size), handler_(handler) {}
+
+    void run() {
+        while (true) {
+            if (readValue()) {
+                // Empty container or scalar: the value is complete.
+                if (closeValues()) {
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+
+    [[noreturn]] void fail(const char* message) const {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(p_ - begin_) + ": " + message);
+    }
+
+    void skipWhitespace() {
+        while (p_ != end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) {
+            ++p_;
+        }
+    }
+
+    char peek() {
+        skipWhitespace();
+        if (p_ == end_) {
+            fail("unexpected end of input");
+        }
+        return *p_;
+    }
+
+    void expect(char c, const char* message) {
+        if (peek() != c) {
+            fail(message);
+        }
+        ++p_;
+    }
+
+    /**
+     * @brief Reads the start of a value.
+     *
+     * @return `true` if the value is complete, `false` if a non-empty container was opened.
+     */
+    bool readValue() {
+        switch (peek()) {
+        case '{':
+            ++p_;
+            handler_.onStartObject();
+            if (peek() == '}') {
+                ++p_;
+                handler_.onEndObject();
+                return true;
+            }
+            open_.push_back('{');
+            readKey();
+            return false;
+        case '[':
+            ++p_;
+            handler_.onStartArray();
+            if (peek() == ']') {
+                ++p_;
+                handler_.onEndArray();
+                return true;
+            }
+            open_.push_back('[');
+            return false;
+        case '"':
+            ++p_;
+            readString();
+            handler_.onString(scratch_);
+            return true;
+        case 't':
+            readLiteral("true", 4);
+            handler_.onBoolean(true);
+            return true;
+        case 'f':
+            readLiteral("false", 5);
+            handler_.onBoolean(false);
+            return true;
+        case 'n':
+            readLiteral("null", 4);
+            handler_.onNull();
+            return true;
+        default:
+            handler_.onNumber(readNumber());
+            return true;
+        }
+    }
+
+    /**
+     * @brief Consumes separators and closing brackets after a complete value.
+     *
+     * @return `true` once the root value is complete.
+     */
+    bool closeValues() {
+        while (true) {
+            if (open_.empty()) {
+                skipWhitespace();
+                if (p_ != end_) {
+                    fail("unexpected data after the root value");
+                }
+                return true;
+            }
+            const char c = peek();
+            ++p_;
+            if (c == ',') {
+                if (open_.back() == '{') {
+                    readKey();
+                }
+                return false;
+            }
+            if (c == '}' && open_.back() == '{') {
+                open_.pop_back();
+                handler_.onEndObject();
+            } else if (c == ']' && open_.back() == '[') {
+                open_.pop_back();
+                handler_.onEndArray();
+            } else {
+                --p_;
+                fail("expected ',' or a closing bracket");
+            }
+        }
+    }
+
+    void readKey() {
+        expect('"', "expected a member name");
+        readString();
+        handler_.onKey(scratch_);
+        expect(':', "expected ':'");
+    }
+
+    void readLiteral(const char* literal, size_t size) {
+        if (static_cast<size_t>(end_ - p_) < size || std::memcmp(p_, literal, size) != 0) {
+            fail("invalid literal");
+        }
+        p_ += size;
+    }
+
+    unsigned readHex4() {
+        if (end_ - p_ < 4) {
+            fail("truncated unicode escape");
+        }
+        unsigned code = 0;
+        for (int i = 0; i < 4; ++i, ++p_) {
+            const char c = *p_;
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<unsigned>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<unsigned>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<unsigned>(c - 'A' + 10);
+            } else {
+                fail("invalid unicode escape");
+            }
+        }
+        return code;
+    }
+
+    void appendUtf8(unsigned code) {
+        if (code < 0x80) {
+            scratch_ += static_cast<char>(code);
+        } else if (code < 0x800) {
+            scratch_ += static_cast<char>(0xC0 | (code >> 6));
+            scratch_ += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            scratch_ += static_cast<char>(0xE0 | (code >> 12));
+            scratch_ += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            scratch_ += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            scratch_ += static_cast<char>(0xF0 | (code >> 18));
+            scratch_ += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            scratch_ += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            scratch_ += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    /**
+     * @brief Decodes a string into `scratch_`, the opening quote being consumed.
+     */
+    void readString() {
+        scratch_.clear();
+        while (true) {
+            const char* run = p_;
+            while (p_ != end_ && *p_ != '"' && *p_ != '\\' && static_cast<unsigned char>(*p_) >= 0x20) {
+                ++p_;
+            }
+            scratch_.append(run, p_);
+            if (p_ == end_) {
+                fail("unterminated string");
+            }
+            const char c = *p_++;
+            if (c == '"') {
+                return;
+            }
+            if (c != '\\') {
+                --p_;
+                fail("control character in string");
+            }
+            if (p_ == end_) {
+                fail("unterminated string");
+            }
+            switch (*p_++) {
+            case '"': scratch_ += '"'; break;
+            case '\\': scratch_ += '\\'; break;
+            case '/': scratch_ += '/'; break;
+            case 'b': scratch_ += '\b'; break;
+            case 'f': scratch_ += '\f'; break;
+            case 'n': scratch_ += '\n'; break;
+            case 'r': scratch_ += '\r'; break;
+            case 't': scratch_ += '\t'; break;
+            case 'u': {
+                unsigned code = readHex4();
+                if (code >= 0xD800 && code < 0xDC00) {
+                    if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u') {
+                        fail("unpaired surrogate");
+                    }
+                    p_ += 2;
+                    const unsigned low = readHex4();
+                    if (low < 0xDC00 || low >= 0xE000) {
+                        fail("unpaired surrogate");
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code >= 0xDC00 && code < 0xE000) {
+                    fail("unpaired surrogate");
+                }
+                appendUtf8(code);
+                break;
+            }
+            default:
+                fail("invalid escape");
+            }
+        }
+    }
+
+    static bool isDigit(char c) { return static_cast<unsigned>(c - '0') <= 9; }
+
+    /**
+     * @brief Reads a number. Integers of up to 18 digits are converted without `strtod`.
+     */
+    double readNumber() {
+        const char* start = p_;
+        const bool negative = p_ != end_ && *p_ == '-';
+        if (negative) {
+            ++p_;
+        }
+        if (p_ == end_ || !isDigit(*p_)) {
+            fail("invalid value");
+        }
+        uint64_t integer = 0;
+        size_t digits = 0;
+        if (*p_ == '0') {
+            ++p_;
+            digits = 1;
+        } else {
+            while (p_ != end_ && isDigit(*p_)) {
+                integer = integer * 10 + static_cast<unsigned>(*p_++ - '0');
+                ++digits;
+            }
+        }
+        bool exact = digits <= 18;
+        if (p_ != end_ && *p_ == '.') {
+            ++p_;
+            if (p_ == end_ || !isDigit(*p_)) {
+                fail("invalid number");
+            }
+            while (p_ != end_ && isDigit(*p_)) {
+                ++p_;
+            }
+            exact = false;
+        }
+        if (p_ != end_ && (*p_ == 'e' || *p_ == 'E')) {
+            ++p_;
+            if (p_ != end_ && (*p_ == '+' || *p_ == '-')) {
+                ++p_;
+            }
+            if (p_ == end_ || !isDigit(*p_)) {
+                fail("invalid number");
+            }
+            while (p_ != end_ && isDigit(*p_)) {
+                ++p_;
+            }
+            exact = false;
+        }
+        if (exact) {
+            const double value = static_cast<double>(integer);
+            return negative ? -value : value;
+        }
+        // The input may end right after the number, so it is copied before `strtod`.
+        number_.assign(start, p_);
+        return std::strtod(number_.c_str(), nullptr);
+    }
+};
+
+/**
+ * @brief Returns an upper estimate of the number of values in a JSON document.
+ *
+ * Counts the commas and opening brackets outside strings in one pass.
+ */
+inline size_t estimateJsonValues(const char* data, size_t size) {
+    size_t count = 1;
+    bool inString = false;
+    for (const char* p = data, *end = data + size; p != end; ++p) {
+        const char c = *p;
+        if (inString) {
+            if (c == '\\') {
+                if (++p == end) {
+                    break;
+                }
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == ',' || c == '[' || c == '{') {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parses a JSON document (RFC 8259) and forwards SAX events to a handler.
+ *
+ * The parser keeps an explicit stack of open containers, so deep documents do not recurse.
+ * The handler must provide `onNull()`, `onBoolean(bool)`, `onNumber(double)`,
+ * `onString(const std::string&)`, `onKey(const std::string&)`, `onStartObject()`,
+ * `onEndObject()`, `onStartArray()` and `onEndArray()`. Strings are handed over decoded as
+ * UTF-8, in a buffer reused by the next string.
+ *
+ * @tparam Handler The type of the event handler.
+ * @param data The document.
+ * @param size The size of the document in bytes.
+ * @param handler The event handler.
+ * @throw std::runtime_error If the document is not valid JSON.
+ */
+template <typename Handler>
+void parseJson(const char* data, size_t size, Handler& handler) {
+    detail::JsonParser<Handler>(data, size, handler).run();
+}
+
+/**
+ * @brief SAX handler appending one tree node per JSON value.
+ *
+ * The first value becomes the root, which must already exist in the tree; every later
+ * value is added under the innermost open container, tracked on a stack of node indices.
+ */
+class JsonTreeBuilder {
+
+    lightweight::Tree<JsonNode>& tree_; ///< Tree being built.
+    std::vector<size_t> parents_;       ///< Indices of the open containers.
+    std::string key_;                   ///< Name of the next object member.
+    size_t lastIndex_ = 0;              ///< Index of the last node added.
+    bool started_ = false;              ///< Whether the root value has been seen.
+
+public:
+    explicit JsonTreeBuilder(lightweight::Tree<JsonNode>& tree) : tree_(tree) {}
+
+    void onNull() { add(JsonType::Null); }
+    void onBoolean(bool value) { add(JsonType::Boolean).boolean = value; }
+    void onNumber(double value) { add(JsonType::Number).number = value; }
+    void onString(const std::string& value) { add(JsonType::String).text = value; }
+    void onKey(const std::string& key) { key_ = key; }
+    void onStartObject() { add(JsonType::Object); parents_.push_back(lastIndex_); }
+    void onEndObject() { parents_.pop_back(); }
+    void onStartArray() { add(JsonType::Array); parents_.push_back(lastIndex_); }
+    void onEndArray() { parents_.pop_back(); }
+
+private:
+
+    JsonNode& add(JsonType type) {
+        if (!started_) {
+            started_ = true;
+            lastIndex_ = 0;
+            tree_.getNode(0).value().type = type;
+            return tree_.getNode(0).value();
+        }
+        const size_t parent = parents_.back();
+        lastIndex_ = tree_.addChild(parent, JsonNode(type));
+        JsonNode& node = tree_.getNode(lastIndex_).value();
+        if (tree_.getNode(parent).value().type == JsonType::Object) {
+            node.key = key_;
+        }
+        return node;
+    }
+};
+
+/**
+ * @brief Builds a tree from a JSON document, one node per object, array or value.
+ *
+ * No DOM is built: values are appended to the tree as the parser reports them, and node
+ * storage is reserved up front from a quick count of the document's separators.
+ *
+ * @param data The document.
+ * @param size The size of the document in bytes.
+ * @return The tree, whose root is the document's root value.
+ * @throw std::runtime_error If the document is not valid JSON.
+ */
+inline lightweight::Tree<JsonNode> parseJsonTree(const char* data, size_t size) {
+    lightweight::Tree<JsonNode> tree(JsonNode(), detail::estimateJsonValues(data, size));
+    JsonTreeBuilder builder(tree);
+    parseJson(data, size, builder);
+    return tree;
+}
+
+inline lightweight::Tree<JsonNode> parseJsonTree(const std::string& text) {
+    return parseJsonTree(text.data(), text.size());
+}
+
+/**
+ * @brief Builds a tree from a JSON file, which is mapped in memory rather than read.
+ *
+ * See `parseJsonTree`.
+ *
+ * @param path The path of the file.
+ * @return The tree, whose root is the document's root value.
+ * @throw std::system_error If the file cannot be mapped.
+ * @throw std::runtime_error If the document is not valid JSON.
+ */
+inline lightweight::Tree<JsonNode> loadJsonTree(const std::string& path) {
+    MappedFile file(path);
+    return parseJsonTree(file.data(), file.size());
+}
+
+} // namespace io
+} // namespace vpr
+
+#endif // JSON_TREE_HPP
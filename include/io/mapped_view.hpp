@@ -0,0 +1,280 @@
+#ifndef MAPPED_VIEW_HPP
+#define MAPPED_VIEW_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "flat_layout.hpp"
+#include "postorder_iterator.hpp"
+#include "preorder_iterator.hpp"
+#include "bfs_iterator.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Read-only, shared memory mapping of a whole file (POSIX `mmap`).
+ *
+ * Pages are loaded lazily from the page cache, so processes mapping the same file share a
+ * single physical copy. The mapping is released on destruction.
+ */
+class MappedFile {
+
+    const char* data_ = nullptr; ///< Start of the mapping.
+    size_t size_ = 0;            ///< Size of the mapping in bytes.
+
+public:
+
+    /**
+     * @brief Maps a file in memory.
+     *
+     * @param path The path of the file.
+     * @throw std::system_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+        size_ = static_cast<size_t>(status.st_size);
+        if (size_ != 0) {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+            }
+            data_ = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    inline const char* data() const noexcept { return data_; }
+    inline size_t size() const noexcept { return size_; }
+
+private:
+
+    void unmap() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+        }
+    }
+};
+
+/**
+ * @brief Read-only graph or digraph view over a file written by `saveFlatGraph`.
+ *
+ * Opening maps the file and checks its header and size; nothing is parsed or copied, and
+ * node records are accessed in place. The records themselves are trusted: a file modified
+ * after being written may produce out-of-range edges.
+ *
+ * @tparam T The type of the values, which must match the type used to write the file.
+ */
+template <typename T>
+class MappedGraph {
+public:
+    using Node = FlatNode<T>;
+
+protected:
+
+    MappedFile file_;            ///< The mapping.
+    const FileHeader* header_;   ///< Header at the start of the mapping.
+    const Node* nodes_;          ///< Node records.
+
+    MappedGraph(const std::string& path, TopologyKind kind) : file_(path), header_(nullptr), nodes_(nullptr) {
+        if (file_.size() < sizeof(FileHeader)) {
+            throw std::runtime_error("Not a flat graph file.");
+        }
+        header_ = reinterpret_cast<const FileHeader*>(file_.data());
+        if (std::memcmp(header_->magic, "VPRB", 4) != 0 || header_->version != BINARY_FORMAT_VERSION
+            || header_->byteOrder != detail::BYTE_ORDER_MARK) {
+            throw std::runtime_error("Not a compatible flat graph file.");
+        }
+        if (header_->kind != static_cast<uint8_t>(kind) || header_->valueSize != sizeof(T)
+            || header_->valueEncoding != static_cast<uint8_t>(ValueEncoding::Raw)) {
+            throw std::runtime_error("Flat file holds another kind of topology or value.");
+        }
+        detail::FlatLayout layout = detail::flatLayout<T>(header_->nodeCount, header_->edgeCount);
+        if (file_.size() < layout.size) {
+            throw std::runtime_error("Flat file is truncated.");
+        }
+        nodes_ = reinterpret_cast<const Node*>(file_.data() + layout.records);
+    }
+
+public:
+
+    /**
+     * @brief Maps a file written by `saveFlatGraph`.
+     *
+     * @param path The path of the file.
+     * @throw std::system_error If the file cannot be mapped.
+     * @throw std::runtime_error If the file is not a flat graph with values of type `T`.
+     */
+    explicit MappedGraph(const std::string& path) : MappedGraph(path, TopologyKind::FlatAdjacency) {}
+
+    inline size_t size() const noexcept { return static_cast<size_t>(header_->nodeCount); }
+    inline bool empty() const noexcept { return header_->nodeCount == 0; }
+    inline size_t edgeCount() const noexcept { return static_cast<size_t>(header_->edgeCount); }
+    inline bool isNormalized() const noexcept { return (header_->flags & FLAG_NORMALIZED) != 0; }
+
+    /**
+     * @brief Views never contain removed nodes, which are dropped when writing.
+     */
+    inline bool isRemoved(size_t) const noexcept { return false; }
+
+    /**
+     * @brief Access a node record by its index.
+     *
+     * @param index The index of the node.
+     * @return A reference to the record in the mapping.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    const Node& getNode(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Invalid node index.");
+        }
+        return nodes_[index];
+    }
+
+    const Node* begin() const noexcept { return nodes_; }
+    const Node* end() const noexcept { return nodes_ + size(); }
+};
+
+/**
+ * @brief Read-only tree view over a file written by `saveFlatTree`.
+ *
+ * Supports the same traversal iterators as `templates::Tree`, running directly over the
+ * mapped records.
+ *
+ * @tparam T The type of the values, which must match the type used to write the file.
+ */
+template <typename T>
+class MappedTree : public MappedGraph<T> {
+    using Base = MappedGraph<T>;
+
+public:
+    using Node = FlatNode<T>;
+
+private:
+    template <typename Traversal>
+    using ConstIterator = TreeIterator<const Node, const MappedTree, Traversal>;
+
+    using PreOrderTraversalType = PreOrderTraversal<const MappedTree>;
+    using PostOrderTraversalType = PostOrderTraversal<const Node, const MappedTree>;
+    using BFSTraversalType = BFSTraversal<const MappedTree>;
+    using ReverseBFSTraversalType = ReverseBFSTraversal<const MappedTree>;
+    using ReversePreOrderTraversalType = ReversePreOrderTraversal<const MappedTree>;
+
+public:
+
+    /**
+     * @brief Maps a file written by `saveFlatTree`.
+     *
+     * @param path The path of the file.
+     * @throw std::system_error If the file cannot be mapped.
+     * @throw std::runtime_error If the file is not a flat tree with values of type `T`.
+     */
+    explicit MappedTree(const std::string& path) : Base(path, TopologyKind::FlatTree) {}
+
+    inline const Node& getRoot() const { return Base::getNode(0); }
+
+    /**
+     * @brief Returns the position of a node among the children of its parent.
+     *
+     * @param index The index of the node.
+     * @return The child index, 0 for the root.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t childIndex(size_t index) const { return Base::getNode(index).childIndex(); }
+
+    /**
+     * @brief Returns the next sibling of a node in O(1).
+     *
+     * @param index The index of the node.
+     * @return The index of the sibling, or `static_cast<size_t>(-1)` if there is none.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t nextSibling(size_t index) const {
+        const Node& node = Base::getNode(index);
+        if (index == 0) {
+            return static_cast<size_t>(-1);
+        }
+        EdgeSpan siblings = this->nodes_[node.parentId()].edges();
+        const size_t next = node.childIndex() + 1;
+        return next < siblings.size() ? static_cast<size_t>(siblings[next]) : static_cast<size_t>(-1);
+    }
+
+    /**
+     * @brief Returns the previous sibling of a node in O(1).
+     *
+     * @param index The index of the node.
+     * @return The index of the sibling, or `static_cast<size_t>(-1)` if there is none.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t prevSibling(size_t index) const {
+        const Node& node = Base::getNode(index);
+        if (index == 0 || node.childIndex() == 0) {
+            return static_cast<size_t>(-1);
+        }
+        return static_cast<size_t>(this->nodes_[node.parentId()].edges()[node.childIndex() - 1]);
+    }
+
+    // *** Traversal Iterator Methods ***
+    inline ConstIterator<PreOrderTraversalType> pre_order_begin() const { return ConstIterator<PreOrderTraversalType>(this, start()); }
+    inline ConstIterator<PreOrderTraversalType> pre_order_end()   const { return ConstIterator<PreOrderTraversalType>(this, static_cast<size_t>(-1)); }
+
+    inline ConstIterator<PostOrderTraversalType> post_order_begin() const { return ConstIterator<PostOrderTraversalType>(this, start()); }
+    inline ConstIterator<PostOrderTraversalType> post_order_end()   const { return ConstIterator<PostOrderTraversalType>(this, static_cast<size_t>(-1)); }
+
+    inline ConstIterator<BFSTraversalType> bfs_begin() const { return ConstIterator<BFSTraversalType>(this, start()); }
+    inline ConstIterator<BFSTraversalType> bfs_end()   const { return ConstIterator<BFSTraversalType>(this, static_cast<size_t>(-1)); }
+
+    inline ConstIterator<ReverseBFSTraversalType> bfs_rbegin() const { return ConstIterator<ReverseBFSTraversalType>(this, start()); }
+    inline ConstIterator<ReverseBFSTraversalType> bfs_rend()   const { return ConstIterator<ReverseBFSTraversalType>(this, static_cast<size_t>(-1)); }
+
+    inline ConstIterator<ReversePreOrderTraversalType> pre_order_rbegin() const { return ConstIterator<ReversePreOrderTraversalType>(this, start()); }
+    inline ConstIterator<ReversePreOrderTraversalType> pre_order_rend()   const { return ConstIterator<ReversePreOrderTraversalType>(this, static_cast<size_t>(-1)); }
+
+private:
+
+    size_t start() const noexcept { return Base::empty() ? static_cast<size_t>(-1) : 0; }
+};
+
+} // namespace io
+} // namespace vpr
+
+#endif // MAPPED_VIEW_HPP
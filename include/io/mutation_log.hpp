@@ -0,0 +1,701 @@
+#ifndef MUTATION_LOG_HPP
+#define MUTATION_LOG_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "binary_format.hpp"
+#include "graph_kind.hpp"
+#include "mapped_view.hpp"
+
+namespace vpr {
+namespace io {
+
+/**
+ * @brief Serializer copying the bytes of trivially copyable values.
+ */
+template <typename T>
+struct RawSerializer {
+    static_assert(std::is_trivially_copyable<T>::value, "RawSerializer needs trivially copyable values.");
+
+    void write(std::ostream& out, const T& value) const {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    T read(std::istream& in) const {
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of binary data.");
+        }
+        return value;
+    }
+};
+
+/**
+ * @brief Durability settings of a mutation log.
+ */
+struct LogOptions {
+    size_t groupCommitBytes = size_t(1) << 16; ///< Pending bytes that trigger a commit, capped at `MAX_LOG_BATCH_BYTES`.
+    size_t snapshotInterval = 0;               ///< Committed records between snapshots, 0 for manual snapshots.
+    bool sync = true;                          ///< Whether commits and snapshots wait for the disk (`fdatasync`).
+};
+
+/**
+ * @brief Largest batch size that triggers a commit on its own.
+ *
+ * Batch frames store their size in 32 bits; committing at half of that leaves room for the
+ * record that crosses the threshold.
+ */
+constexpr size_t MAX_LOG_BATCH_BYTES = size_t(UINT32_MAX) / 2;
+
+namespace detail {
+
+enum class LogOp : uint8_t { AddChild = 1, AddNode = 2, AddEdge = 3 };
+
+constexpr uint32_t LOG_FORMAT_VERSION = 1;
+
+/**
+ * @brief Header of both the log and the snapshot files.
+ *
+ * A log only applies to the snapshot of the same generation; each snapshot starts a new one.
+ */
+struct LogHeader {
+    char magic[4];       ///< `VPRL` for logs, `VPRS` for snapshots.
+    uint32_t version;    ///< `LOG_FORMAT_VERSION`.
+    uint64_t generation; ///< Generation of the snapshot the file belongs to.
+};
+
+static_assert(sizeof(LogHeader) == 16, "LogHeader must not contain padding.");
+
+/**
+ * @brief Frame preceding every group of records in a log.
+ */
+struct BatchHeader {
+    uint32_t size;     ///< Size of the records in bytes.
+    uint32_t checksum; ///< CRC-32 of the records.
+};
+
+inline uint32_t crc32(const char* data, size_t size) {
+    static const std::vector<uint32_t> table = []() {
+        std::vector<uint32_t> entries(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Read-only stream buffer over memory, so that serializers can read mapped records.
+ */
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const char* data, size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+inline void putLogVarint(std::ostream& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+inline uint64_t getLogVarint(std::istream& in) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        const int byte = in.get();
+        if (byte == std::char_traits<char>::eof()) {
+            throw std::runtime_error("Truncated log record.");
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Invalid log record.");
+}
+
+inline void writeAll(int fd, const char* data, size_t size) {
+    while (size != 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Cannot write mutation log");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+inline void syncPath(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+    }
+    const int result = ::fsync(fd);
+    const int error = errno;
+    ::close(fd);
+    if (result != 0) {
+        throw std::system_error(error, std::generic_category(), "Cannot sync " + path);
+    }
+}
+
+inline std::string parentDirectory(const std::string& path) {
+    const size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+}
+
+/**
+ * @brief Replaces a file atomically: writes a temporary file, syncs it, then renames it.
+ */
+template <typename Write>
+void replaceFile(const std::string& path, bool sync, Write write) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create " + temporary);
+        }
+        write(out);
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Cannot write " + temporary);
+        }
+    }
+    if (sync) {
+        syncPath(temporary, O_RDONLY);
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot rename " + temporary);
+    }
+    if (sync) {
+        syncPath(parentDirectory(path), O_RDONLY | O_DIRECTORY);
+    }
+}
+
+inline void writeLogHeader(std::ostream& out, const char* magic, uint64_t generation) {
+    LogHeader header;
+    std::memcpy(header.magic, magic, 4);
+    header.version = LOG_FORMAT_VERSION;
+    header.generation = generation;
+    writeBytes(out, &header, sizeof(header));
+}
+
+inline bool readLogHeader(std::istream& in, const char* magic, uint64_t& generation) {
+    LogHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (std::memcmp(header.magic, magic, 4) != 0 || header.version != LOG_FORMAT_VERSION) {
+        throw std::runtime_error("Not a compatible mutation log file.");
+    }
+    generation = header.generation;
+    return true;
+}
+
+inline std::string snapshotPath(const std::string& path) { return path + ".snap"; }
+
+// Snapshots of trivially copyable values use the bulk raw encoding.
+template <typename TreeType, typename T>
+void saveTreeSnapshot(std::ostream& out, const TreeType& tree, const RawSerializer<T>&) { saveTree(out, tree); }
+template <typename TreeType, typename Serializer>
+void saveTreeSnapshot(std::ostream& out, const TreeType& tree, const Serializer& s) { saveTree(out, tree, s); }
+template <typename TreeType, typename T>
+TreeType loadTreeSnapshot(std::istream& in, const RawSerializer<T>&) { return loadTree<TreeType>(in); }
+template <typename TreeType, typename Serializer>
+TreeType loadTreeSnapshot(std::istream& in, const Serializer& s) { return loadTree<TreeType>(in, s); }
+
+template <typename GraphType, typename T>
+void saveGraphSnapshot(std::ostream& out, const GraphType& graph, const RawSerializer<T>&) { saveGraph(out, graph); }
+template <typename GraphType, typename Serializer>
+void saveGraphSnapshot(std::ostream& out, const GraphType& graph, const Serializer& s) { saveGraph(out, graph, s); }
+template <typename GraphType, typename T>
+GraphType loadGraphSnapshot(std::istream& in, const RawSerializer<T>&) { return loadGraph<GraphType>(in); }
+template <typename GraphType, typename Serializer>
+GraphType loadGraphSnapshot(std::istream& in, const Serializer& s) { return loadGraph<GraphType>(in, s); }
+
+struct TreeSnapshots {
+    template <typename TreeType, typename Serializer>
+    static void save(std::ostream& out, const TreeType& tree, const Serializer& s) { saveTreeSnapshot(out, tree, s); }
+};
+
+struct GraphSnapshots {
+    template <typename GraphType, typename Serializer>
+    static void save(std::ostream& out, const GraphType& graph, const Serializer& s) { saveGraphSnapshot(out, graph, s); }
+};
+
+/**
+ * @brief Opens the snapshot of a log, leaving the stream on its payload.
+ *
+ * @return The generation of the snapshot.
+ */
+inline uint64_t openSnapshot(const std::string& path, std::ifstream& in) {
+    in.open(snapshotPath(path).c_str(), std::ios::binary);
+    uint64_t generation = 0;
+    if (!in || !readLogHeader(in, "VPRS", generation)) {
+        throw std::runtime_error("Missing or truncated snapshot for " + path);
+    }
+    return generation;
+}
+
+/**
+ * @brief Calls `apply(op, stream)` for every record of the committed batches of a log.
+ *
+ * The log is ignored if it belongs to another generation than the snapshot. Reading stops at
+ * the first incomplete or corrupted batch, which was being written when the process stopped.
+ */
+template <typename Apply>
+void replayLog(const std::string& path, uint64_t generation, Apply apply) {
+    {
+        std::ifstream probe(path.c_str(), std::ios::binary);
+        uint64_t logGeneration = 0;
+        if (!probe || !readLogHeader(probe, "VPRL", logGeneration) || logGeneration != generation) {
+            return;
+        }
+    }
+    MappedFile file(path);
+    const char* p = file.data() + sizeof(LogHeader);
+    const char* end = file.data() + file.size();
+    while (static_cast<size_t>(end - p) >= sizeof(BatchHeader)) {
+        BatchHeader batch;
+        std::memcpy(&batch, p, sizeof(batch));
+        p += sizeof(batch);
+        if (batch.size > static_cast<size_t>(end - p) || crc32(p, batch.size) != batch.checksum) {
+            return;
+        }
+        MemoryStreamBuf buffer(p, batch.size);
+        std::istream records(&buffer);
+        while (records.peek() != std::char_traits<char>::eof()) {
+            apply(static_cast<LogOp>(records.get()), records);
+        }
+        p += batch.size;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Write-ahead log of the mutations of a structure, shared by `TreeLog` and `GraphLog`.
+ *
+ * Mutations are encoded as compact records (an opcode, varint indices and the serialized
+ * value) into an in-memory batch. A batch is committed, that is framed with its size and a
+ * CRC-32, appended to the log file and synced, when it reaches `groupCommitBytes` or when
+ * `commit()` is called, so many mutations share one disk write. `snapshot()` writes the
+ * whole structure with the binary format and starts an empty log of the next generation.
+ *
+ * Only mutations made through the log are recorded: the structure must not be modified
+ * directly while it is logged.
+ *
+ * @tparam GraphType The type of the logged structure.
+ * @tparam Serializer The value serializer, see `saveTree`.
+ * @tparam Snapshots Writer of snapshots.
+ */
+template <typename GraphType, typename Serializer, typename Snapshots>
+class MutationLog {
+protected:
+
+    GraphType& graph_;            ///< Logged structure.
+    std::string path_;            ///< Path of the log file; the snapshot is at `path_ + ".snap"`.
+    LogOptions options_;          ///< Durability settings.
+    Serializer serializer_;       ///< Value serializer.
+    int fd_ = -1;                 ///< Log file, opened for appending.
+    uint64_t generation_ = 0;     ///< Generation of the current snapshot and log.
+    std::ostringstream batch_;    ///< Records not committed yet.
+    size_t pendingRecords_ = 0;   ///< Number of records in `batch_`.
+    size_t committedRecords_ = 0; ///< Records committed since the last snapshot.
+    uint64_t committedBytes_ = 0; ///< Size of the log file up to the end of the last committed batch.
+    bool failed_ = false;         ///< Whether a failed commit could not be rolled back.
+
+    /**
+     * @brief Starts logging a structure, writing its first snapshot.
+     */
+    MutationLog(GraphType& graph, const std::string& path, const LogOptions& options, Serializer serializer)
+        : graph_(graph), path_(path), options_(options), serializer_(std::move(serializer)) {
+        std::ifstream previous(detail::snapshotPath(path_).c_str(), std::ios::binary);
+        if (previous) {
+            detail::readLogHeader(previous, "VPRS", generation_);
+        }
+        snapshot();
+    }
+
+    void beginRecord(detail::LogOp op) {
+        batch_.put(static_cast<char>(op));
+        ++pendingRecords_;
+    }
+
+    void putIndex(size_t index) { detail::putLogVarint(batch_, index); }
+
+    template <typename T>
+    void putValue(const T& value) { serializer_.write(batch_, value); }
+
+    void endRecord() {
+        const size_t threshold = std::min(options_.groupCommitBytes, MAX_LOG_BATCH_BYTES);
+        if (static_cast<size_t>(batch_.tellp()) >= threshold) {
+            commit();
+        }
+    }
+
+public:
+
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+
+    /**
+     * @brief Commits the pending records, ignoring errors. Call `commit()` to observe them.
+     */
+    ~MutationLog() {
+        try {
+            commit();
+        } catch (...) {
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    /**
+     * @brief Appends the pending records to the log file as one batch.
+     *
+     * When `sync` is set, returns once the batch is on disk. Triggers a snapshot every
+     * `snapshotInterval` committed records.
+     *
+     * If writing or syncing fails, the file is truncated back to the last committed batch and
+     * the records stay pending, so that `commit()` can be retried and recovery never sees a
+     * torn or duplicated batch in front of later ones. If the file cannot be truncated, the
+     * log refuses further commits until `snapshot()` starts a new one.
+     *
+     * A batch cannot exceed 4 GiB, which only a single record of about 2 GiB or more can
+     * reach; such a record can only be persisted by `snapshot()`.
+     *
+     * @throw std::length_error If the pending records do not fit in one batch.
+     * @throw std::system_error If writing fails.
+     * @throw std::runtime_error If a previous failure could not be rolled back.
+     */
+    void commit() {
+        if (failed_) {
+            throw std::runtime_error("Mutation log is in a failed state, take a snapshot to restart it.");
+        }
+        if (pendingRecords_ == 0) {
+            return;
+        }
+        const std::string records = batch_.str();
+        if (records.size() > UINT32_MAX) {
+            throw std::length_error("Mutation log batch exceeds 4 GiB, take a snapshot instead.");
+        }
+        detail::BatchHeader header;
+        header.size = static_cast<uint32_t>(records.size());
+        header.checksum = detail::crc32(records.data(), records.size());
+        std::string frame(reinterpret_cast<const char*>(&header), sizeof(header));
+        frame += records;
+        try {
+            detail::writeAll(fd_, frame.data(), frame.size());
+            if (options_.sync && ::fdatasync(fd_) != 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot sync mutation log");
+            }
+        } catch (...) {
+            if (::ftruncate(fd_, static_cast<off_t>(committedBytes_)) != 0) {
+                failed_ = true;
+            }
+            throw;
+        }
+        committedBytes_ += frame.size();
+        batch_.str(std::string());
+        committedRecords_ += pendingRecords_;
+        pendingRecords_ = 0;
+        if (options_.snapshotInterval != 0 && committedRecords_ >= options_.snapshotInterval) {
+            snapshot();
+        }
+    }
+
+    /**
+     * @brief Writes the whole structure as a snapshot and starts an empty log.
+     *
+     * Pending records are not written to the log, as the snapshot contains them. The new
+     * snapshot replaces the previous one atomically; a log left over by a crash is ignored
+     * on recovery because it belongs to the previous generation.
+     *
+     * @throw std::invalid_argument If the structure contains removed nodes.
+     * @throw std::system_error If writing fails.
+     */
+    void snapshot() {
+        if (graph_.liveSize() != graph_.size()) {
+            throw std::invalid_argument("Cannot snapshot a structure with removed nodes, compact it first.");
+        }
+        const uint64_t generation = generation_ + 1;
+        detail::replaceFile(detail::snapshotPath(path_), options_.sync, [&](std::ostream& out) {
+            detail::writeLogHeader(out, "VPRS", generation);
+            Snapshots::save(out, graph_, serializer_);
+        });
+        detail::replaceFile(path_, options_.sync, [&](std::ostream& out) {
+            detail::writeLogHeader(out, "VPRL", generation);
+        });
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path_);
+        }
+        const off_t end = ::lseek(fd_, 0, SEEK_END);
+        if (end < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path_);
+        }
+        generation_ = generation;
+        batch_.str(std::string());
+        pendingRecords_ = 0;
+        committedRecords_ = 0;
+        committedBytes_ = static_cast<uint64_t>(end);
+        failed_ = false;
+    }
+
+    inline uint64_t generation() const noexcept { return generation_; }
+    inline size_t pendingRecords() const noexcept { return pendingRecords_; }
+    inline bool failed() const noexcept { return failed_; }
+    inline const std::string& path() const noexcept { return path_; }
+};
+
+/**
+ * @brief Write-ahead log of the `addChild` calls made on a tree.
+ *
+ * Recover the tree with `recoverTree`, then start a new log on it.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree`.
+ * @tparam Serializer The value serializer, `RawSerializer` by default.
+ */
+template <typename TreeType, typename Serializer = RawSerializer<typename TreeType::Node::DataType>>
+class TreeLog : public MutationLog<TreeType, Serializer, detail::TreeSnapshots> {
+    using Base = MutationLog<TreeType, Serializer, detail::TreeSnapshots>;
+    using T = typename TreeType::Node::DataType;
+
+public:
+
+    /**
+     * @brief Starts logging a tree, writing a snapshot of its current state.
+     *
+     * @param tree The tree to log.
+     * @param path The path of the log file; the snapshot is written next to it.
+     * @param options Durability settings.
+     * @param serializer The value serializer.
+     * @throw std::system_error If the files cannot be written.
+     */
+    TreeLog(TreeType& tree, const std::string& path, const LogOptions& options = LogOptions(),
+            Serializer serializer = Serializer())
+        : Base(tree, path, options, std::move(serializer)) {}
+
+    /**
+     * @brief Adds a child to the tree and records it.
+     *
+     * @param parent_index The index of the parent node.
+     * @param value The value of the child.
+     * @return The index of the new child.
+     * @throw std::out_of_range If the parent index is invalid.
+     */
+    size_t addChild(size_t parent_index, T value) {
+        const size_t id = this->graph_.addChild(parent_index, std::move(value));
+        this->beginRecord(detail::LogOp::AddChild);
+        this->putIndex(parent_index);
+        this->putValue(this->graph_.getNode(id).value());
+        this->endRecord();
+        return id;
+    }
+};
+
+/**
+ * @brief Write-ahead log of the `emplace_node` and `addEdge` calls made on a graph.
+ *
+ * Recover the graph with `recoverGraph`, then start a new log on it.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @tparam Serializer The value serializer, `RawSerializer` by default.
+ */
+template <typename GraphType, typename Serializer = RawSerializer<typename GraphType::Node::DataType>>
+class GraphLog : public MutationLog<GraphType, Serializer, detail::GraphSnapshots> {
+    using Base = MutationLog<GraphType, Serializer, detail::GraphSnapshots>;
+
+public:
+
+    /**
+     * @brief Starts logging a graph, writing a snapshot of its current state.
+     *
+     * See `TreeLog::TreeLog`.
+     */
+    GraphLog(GraphType& graph, const std::string& path, const LogOptions& options = LogOptions(),
+             Serializer serializer = Serializer())
+        : Base(graph, path, options, std::move(serializer)) {}
+
+    /**
+     * @brief Constructs a node in the graph and records it.
+     *
+     * @param args Arguments forwarded to the value constructor.
+     * @return The index of the new node.
+     */
+    template <typename... Args>
+    size_t emplace_node(Args&&... args) {
+        const size_t id = this->graph_.emplace_node(std::forward<Args>(args)...);
+        this->beginRecord(detail::LogOp::AddNode);
+        this->putValue(this->graph_.getNode(id).value());
+        this->endRecord();
+        return id;
+    }
+
+    /**
+     * @brief Adds an edge to the graph and records it.
+     *
+     * @param from The index of the source node.
+     * @param to The index of the target node.
+     * @throw std::out_of_range If either index is invalid.
+     */
+    void addEdge(size_t from, size_t to) {
+        this->graph_.addEdge(from, to);
+        this->beginRecord(detail::LogOp::AddEdge);
+        this->putIndex(from);
+        this->putIndex(to);
+        this->endRecord();
+    }
+};
+
+/**
+ * @brief Rebuilds a tree from the snapshot and the committed records of a `TreeLog`.
+ *
+ * The snapshot is read with the bulk `loadTree` path, then node storage is reserved for all
+ * the logged children before they are appended.
+ *
+ * @tparam TreeType The type of the tree.
+ * @tparam Serializer The value serializer used by the log.
+ * @param path The path of the log file.
+ * @param serializer The value serializer.
+ * @return The recovered tree.
+ * @throw std::runtime_error If the snapshot is missing or not compatible.
+ */
+template <typename TreeType, typename Serializer = RawSerializer<typename TreeType::Node::DataType>>
+TreeType recoverTree(const std::string& path, Serializer serializer = Serializer()) {
+    using T = typename TreeType::Node::DataType;
+    std::ifstream snapshot;
+    const uint64_t generation = detail::openSnapshot(path, snapshot);
+    TreeType tree = detail::loadTreeSnapshot<TreeType>(snapshot, serializer);
+
+    std::vector<size_t> parents;
+    std::vector<T> values;
+    detail::replayLog(path, generation, [&](detail::LogOp op, std::istream& in) {
+        if (op != detail::LogOp::AddChild) {
+            throw std::runtime_error("Unexpected record in a tree log.");
+        }
+        parents.push_back(static_cast<size_t>(detail::getLogVarint(in)));
+        values.push_back(serializer.read(in));
+    });
+    tree.reserve(tree.size() + parents.size());
+    for (size_t i = 0; i < parents.size(); ++i) {
+        tree.addChild(parents[i], std::move(values[i]));
+    }
+    return tree;
+}
+
+/**
+ * @brief Rebuilds a graph from the snapshot and the committed records of a `GraphLog`.
+ *
+ * The snapshot is read with the bulk `loadGraph` path. Logged nodes are appended, then the
+ * snapshot's adjacency and the logged edges are merged in CSR form and assigned with
+ * `assignAdjacency`, instead of calling `addEdge` once per record.
+ *
+ * @tparam GraphType The type of the graph, e.g. `lightweight::Graph` or `lightweight::Digraph`.
+ * @tparam Serializer The value serializer used by the log.
+ * @param path The path of the log file.
+ * @param serializer The value serializer.
+ * @return The recovered graph.
+ * @throw std::runtime_error If the snapshot is missing or not compatible.
+ */
+template <typename GraphType, typename Serializer = RawSerializer<typename GraphType::Node::DataType>>
+GraphType recoverGraph(const std::string& path, Serializer serializer = Serializer()) {
+    using T = typename GraphType::Node::DataType;
+    std::ifstream snapshot;
+    const uint64_t generation = detail::openSnapshot(path, snapshot);
+    GraphType graph = detail::loadGraphSnapshot<GraphType>(snapshot, serializer);
+
+    std::vector<T> values;
+    std::vector<std::pair<size_t, size_t>> edges;
+    detail::replayLog(path, generation, [&](detail::LogOp op, std::istream& in) {
+        if (op == detail::LogOp::AddNode) {
+            values.push_back(serializer.read(in));
+        } else if (op == detail::LogOp::AddEdge) {
+            const size_t from = static_cast<size_t>(detail::getLogVarint(in));
+            const size_t to = static_cast<size_t>(detail::getLogVarint(in));
+            edges.emplace_back(from, to);
+        } else {
+            throw std::runtime_error("Unexpected record in a graph log.");
+        }
+    });
+    if (values.empty() && edges.empty()) {
+        return graph;
+    }
+
+    graph.reserve(graph.size() + values.size());
+    for (T& value : values) {
+        graph.emplace_node(std::move(value));
+    }
+    const bool undirected = IsUndirected<GraphType>::value;
+    const size_t n = graph.size();
+    std::vector<size_t> offsets(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] = graph.getNode(i).edges().size();
+    }
+    for (const auto& edge : edges) {
+        if (edge.first >= n || edge.second >= n) {
+            throw std::runtime_error("Invalid edge in a graph log.");
+        }
+        ++offsets[edge.first + 1];
+        if (undirected && edge.first != edge.second) {
+            ++offsets[edge.second + 1];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<size_t> targets(offsets[n]);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t target : graph.getNode(i).edges()) {
+            targets[cursor[i]++] = target;
+        }
+    }
+    for (const auto& edge : edges) {
+        targets[cursor[edge.first]++] = edge.second;
+        if (undirected && edge.first != edge.second) {
+            targets[cursor[edge.second]++] = edge.first;
+        }
+    }
+    graph.assignAdjacency(offsets, targets);
+    return graph;
+}
+
+} // namespace io
+} // namespace vpr
+
+#endif // MUTATION_LOG_HPP
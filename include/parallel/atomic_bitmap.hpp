@@ -0,0 +1,82 @@
+#ifndef ATOMIC_BITMAP_HPP
+#define ATOMIC_BITMAP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace vpr {
+namespace parallel {
+
+/**
+ * @brief A fixed-size bitmap whose bits can be claimed concurrently.
+ *
+ * Each bit is stored in a 64-bit atomic word. `claim` sets a bit and reports whether the
+ * calling thread was the one that flipped it, which lets several workers race for the same
+ * node while guaranteeing that exactly one of them wins.
+ */
+class AtomicBitmap {
+
+    size_t size_;                                 ///< Number of addressable bits.
+    std::unique_ptr<std::atomic<uint64_t>[]> words_; ///< Backing storage, one word per 64 bits.
+
+    static size_t wordCount(size_t bits) noexcept { return (bits + 63) / 64; }
+
+public:
+
+    /**
+     * @brief Constructs a bitmap with all bits cleared.
+     *
+     * @param size Number of bits in the bitmap.
+     */
+    explicit AtomicBitmap(size_t size)
+        : size_(size), words_(new std::atomic<uint64_t>[wordCount(size)]) {
+        clear();
+    }
+
+    /**
+     * @brief Clears every bit. Must not run concurrently with `claim` or `test`.
+     */
+    void clear() noexcept {
+        for (size_t i = 0; i < wordCount(size_); ++i) {
+            words_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Returns the number of bits in the bitmap.
+     *
+     * @return The size of the bitmap.
+     */
+    inline size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Checks whether a bit is set.
+     *
+     * @param index Index of the bit.
+     * @return `true` if the bit is set, otherwise `false`.
+     */
+    inline bool test(size_t index) const noexcept {
+        return (words_[index / 64].load(std::memory_order_relaxed) >> (index % 64)) & 1u;
+    }
+
+    /**
+     * @brief Sets a bit, reporting whether this call was the one that set it.
+     *
+     * @param index Index of the bit.
+     * @return `true` if the bit was previously clear, `false` if another call already set it.
+     */
+    inline bool claim(size_t index) noexcept {
+        const uint64_t mask = uint64_t(1) << (index % 64);
+        std::atomic<uint64_t>& word = words_[index / 64];
+        if (word.load(std::memory_order_relaxed) & mask) {
+            return false;
+        }
+        return !(word.fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+};
+
+} // namespace parallel
+} // namespace vpr
+
+#endif // ATOMIC_BITMAP_HPP
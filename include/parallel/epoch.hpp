@@ -0,0 +1,142 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include "work_stealing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace vpr {
+namespace parallel {
+
+/**
+ * @brief Epoch-based reclamation for structures with one writer and many readers.
+ *
+ * A reader pins the current epoch in a slot before loading shared pointers and unpins it
+ * when done. The writer unlinks an object, then retires it: the object is tagged with the
+ * epoch at retirement and the global epoch advances. `collect` frees the retired objects
+ * whose tag is older than every pinned epoch, since no pinned reader can still hold them.
+ *
+ * Pinning is a compare-and-swap on a slot plus a fence; readers never block the writer.
+ * `retire` and `collect` must only be called by the writer.
+ */
+class EpochManager {
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> pinned; ///< Pinned epoch plus one, 0 when the slot is free.
+    };
+
+    struct Retired {
+        uint64_t epoch;          ///< Global epoch when the object was retired.
+        void* object;            ///< The object to free.
+        void (*deleter)(void*);  ///< Frees the object.
+    };
+
+    std::vector<Slot> slots_;      ///< Reader slots.
+    std::atomic<uint64_t> epoch_;  ///< Global epoch.
+    std::vector<Retired> retired_; ///< Objects waiting for readers to move on, writer only.
+
+public:
+
+    /**
+     * @brief Constructs a manager.
+     *
+     * @param maxReaders Maximum number of simultaneously pinned readers, 0 to use four per
+     *        hardware thread (at least 64).
+     */
+    explicit EpochManager(size_t maxReaders = 0)
+        : slots_(maxReaders != 0 ? maxReaders : std::max<size_t>(64, 4 * hardwareConcurrency())), epoch_(0) {
+        for (auto& slot : slots_) {
+            slot.pinned.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    /**
+     * @brief Frees every retired object. No reader may be pinned anymore.
+     */
+    ~EpochManager() {
+        for (const auto& retired : retired_) {
+            retired.deleter(retired.object);
+        }
+    }
+
+    /**
+     * @brief Pins the current epoch. Shared pointers must be loaded after this call.
+     *
+     * @return The slot to pass to `unpin`.
+     * @throw std::length_error If every slot is in use.
+     */
+    size_t pin() {
+        const size_t n = slots_.size();
+        const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % n;
+        for (size_t k = 0; k < n; ++k) {
+            const size_t slot = (start + k) % n;
+            uint64_t expected = 0;
+            const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+            if (slots_[slot].pinned.compare_exchange_strong(expected, epoch + 1, std::memory_order_relaxed)) {
+                // Pairs with the fence in `collect`: either the writer sees this pin, or this
+                // reader sees every pointer the writer unlinked before collecting.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return slot;
+            }
+        }
+        throw std::length_error("Too many pinned readers.");
+    }
+
+    /**
+     * @brief Releases a slot returned by `pin`.
+     */
+    void unpin(size_t slot) noexcept { slots_[slot].pinned.store(0, std::memory_order_release); }
+
+    /**
+     * @brief Retires an object the writer has unlinked from the shared structure.
+     *
+     * @param object The object.
+     * @param deleter Function freeing the object once no reader can hold it.
+     */
+    void retire(void* object, void (*deleter)(void*)) {
+        retired_.push_back(Retired{ epoch_.fetch_add(1, std::memory_order_acq_rel), object, deleter });
+    }
+
+    /**
+     * @brief Frees the retired objects no pinned reader can hold.
+     *
+     * @return The number of objects freed.
+     */
+    size_t collect() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldest = UINT64_MAX;
+        for (const auto& slot : slots_) {
+            const uint64_t pinned = slot.pinned.load(std::memory_order_acquire);
+            if (pinned != 0) {
+                oldest = std::min(oldest, pinned - 1);
+            }
+        }
+        const size_t before = retired_.size();
+        auto kept = std::partition(retired_.begin(), retired_.end(),
+                                   [oldest](const Retired& retired) { return retired.epoch >= oldest; });
+        for (auto it = kept; it != retired_.end(); ++it) {
+            it->deleter(it->object);
+        }
+        retired_.erase(kept, retired_.end());
+        return before - retired_.size();
+    }
+
+    /**
+     * @brief Returns the number of retired objects not freed yet.
+     */
+    inline size_t pending() const noexcept { return retired_.size(); }
+};
+
+} // namespace parallel
+} // namespace vpr
+
+#endif // EPOCH_HPP
@@ -0,0 +1,218 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "work_stealing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vpr {
+namespace parallel {
+
+/**
+ * @brief A fixed team of persistent worker threads running one team job at a time.
+ *
+ * `run(nWorkers, fn)` has the semantics of `runTeam` without spawning threads: the calling
+ * thread takes part as worker 0 and the pool threads run the other workers. Concurrent
+ * callers are serialized, and a `run` issued from inside a job (nested parallelism) runs
+ * `fn(0)` alone on the calling thread instead of deadlocking, so jobs must not wait for
+ * other workers of their team; work distributed through `ChunkScheduler` meets this, since
+ * a single worker steals every chunk.
+ */
+class ThreadPool {
+
+    std::vector<std::thread> threads_;  ///< Workers 1 to `size() - 1`.
+    std::mutex mutex_;                  ///< Protects the job fields below.
+    std::condition_variable wake_;      ///< Signals a new job or shutdown.
+    std::condition_variable finished_;  ///< Signals that the last worker of a job is done.
+    std::mutex runMutex_;               ///< Serializes concurrent `run` calls.
+    void (*invoke_)(void*, size_t) = nullptr; ///< Calls the current job.
+    void* job_ = nullptr;               ///< The current job.
+    size_t jobWorkers_ = 0;             ///< Number of workers taking part in the current job.
+    size_t running_ = 0;                ///< Pool workers still running the current job.
+    size_t generation_ = 0;             ///< Incremented for every job.
+    bool stop_ = false;                 ///< Whether the pool is shutting down.
+
+    static bool& insideJob() noexcept {
+        static thread_local bool inside = false;
+        return inside;
+    }
+
+    template <typename Fn>
+    static void invoke(void* job, size_t worker) { (*static_cast<Fn*>(job))(worker); }
+
+    void workerLoop(size_t worker) {
+        insideJob() = true;
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            if (worker >= jobWorkers_) {
+                continue;
+            }
+            lock.unlock();
+            invoke_(job_, worker);
+            lock.lock();
+            if (--running_ == 0) {
+                finished_.notify_one();
+            }
+        }
+    }
+
+public:
+
+    /**
+     * @brief Starts a pool.
+     *
+     * @param nThreads Number of workers including the calling thread, so `nThreads - 1`
+     *        threads are started.
+     */
+    explicit ThreadPool(size_t nThreads = hardwareConcurrency()) {
+        const size_t n = nThreads == 0 ? 1 : nThreads;
+        threads_.reserve(n - 1);
+        for (size_t w = 1; w < n; ++w) {
+            threads_.emplace_back([this, w]() { workerLoop(w); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Returns the number of workers, including the calling thread.
+     */
+    inline size_t size() const noexcept { return threads_.size() + 1; }
+
+    /**
+     * @brief Runs `fn(worker)` for `worker` in `[0, min(nWorkers, size()))` and waits.
+     *
+     * @tparam Fn Callable taking the worker index. It must not throw.
+     * @param nWorkers Number of workers wanted.
+     * @param fn Function executed by every worker.
+     */
+    template <typename Fn>
+    void run(size_t nWorkers, Fn fn) {
+        nWorkers = std::min(nWorkers, size());
+        bool& inside = insideJob();
+        if (nWorkers <= 1 || inside) {
+            fn(0);
+            return;
+        }
+        std::lock_guard<std::mutex> serial(runMutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            invoke_ = &ThreadPool::invoke<Fn>;
+            job_ = &fn;
+            jobWorkers_ = nWorkers;
+            running_ = nWorkers - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+        inside = true;
+        fn(0);
+        inside = false;
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [&]() { return running_ == 0; });
+    }
+};
+
+/**
+ * @brief Returns the pool shared by the parallel algorithms, started on first use with one
+ * worker per hardware thread.
+ */
+inline ThreadPool& defaultPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+namespace detail {
+
+template <typename... Ts>
+struct VoidType {
+    using type = void;
+};
+
+} // namespace detail
+
+/**
+ * @brief Detects executors: types with `size()` and `run(nWorkers, fn)` like `ThreadPool`.
+ */
+template <typename E, typename = void>
+struct IsExecutor : std::false_type {};
+
+template <typename E>
+struct IsExecutor<E, typename detail::VoidType<decltype(std::declval<E&>().size()),
+                                               decltype(std::declval<E&>().run(size_t(), std::declval<void (*)(size_t)>()))>::type>
+    : std::true_type {};
+
+/**
+ * @brief Runs `body(chunk)` for every chunk in `[0, nChunks)` on an executor.
+ *
+ * Chunks are distributed through a `ChunkScheduler`. If a call throws, the workers stop
+ * claiming chunks and the first exception is rethrown once all of them have returned.
+ *
+ * @tparam Executor An executor such as `ThreadPool`.
+ * @tparam Body Callable taking a chunk index.
+ * @param executor The executor running the workers.
+ * @param nChunks Number of chunks.
+ * @param body Function processing one chunk.
+ */
+template <typename Executor, typename Body>
+void parallelFor(Executor& executor, size_t nChunks, Body body) {
+    const size_t nWorkers = std::min(executor.size(), nChunks);
+    if (nWorkers <= 1) {
+        for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+            body(chunk);
+        }
+        return;
+    }
+    ChunkScheduler scheduler(nWorkers);
+    scheduler.reset(nChunks);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    executor.run(nWorkers, [&](size_t worker) {
+        size_t chunk;
+        while (!failed.load(std::memory_order_relaxed) && scheduler.next(worker, chunk)) {
+            try {
+                body(chunk);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace parallel
+} // namespace vpr
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,149 @@
+#ifndef WORK_STEALING_HPP
+#define WORK_STEALING_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace vpr {
+namespace parallel {
+
+/**
+ * @brief Returns the number of hardware threads, falling back to 1 when it is unknown.
+ *
+ * @return The number of concurrent threads supported by the machine.
+ */
+inline size_t hardwareConcurrency() noexcept {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<size_t>(n);
+}
+
+/**
+ * @brief A reusable barrier for a fixed-size team of threads.
+ *
+ * Threads spin (yielding) until every member of the team has arrived. The barrier is
+ * sense-reversing, so it can be reused immediately for the next phase.
+ */
+class SpinBarrier {
+
+    const size_t count_;                ///< Number of threads in the team.
+    std::atomic<size_t> waiting_;       ///< Threads that have arrived in the current phase.
+    std::atomic<size_t> generation_;    ///< Incremented every time the barrier opens.
+
+public:
+
+    /**
+     * @brief Constructs a barrier for `count` threads.
+     *
+     * @param count Number of threads that must arrive before the barrier opens.
+     */
+    explicit SpinBarrier(size_t count) : count_(count), waiting_(0), generation_(0) {}
+
+    /**
+     * @brief Blocks until all threads of the team have called `wait`.
+     */
+    void wait() noexcept {
+        const size_t generation = generation_.load(std::memory_order_acquire);
+        if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+            waiting_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        while (generation_.load(std::memory_order_acquire) == generation) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * @brief Distributes a range of chunks among workers, letting idle workers steal.
+ *
+ * The chunks `[0, nChunks)` are split into one contiguous slice per worker. Each worker
+ * consumes its own slice first, which keeps neighbouring chunks on the same core, and then
+ * steals the remaining chunks of the other workers. Claiming a chunk is a single atomic
+ * increment on the owning slice.
+ */
+class ChunkScheduler {
+
+    struct alignas(64) Slice {
+        std::atomic<size_t> next; ///< Next unclaimed chunk of the slice.
+        size_t end;               ///< One past the last chunk of the slice.
+    };
+
+    std::vector<Slice> slices_; ///< One slice per worker.
+
+public:
+
+    /**
+     * @brief Constructs a scheduler for a fixed number of workers.
+     *
+     * @param nWorkers Number of workers that will call `next`.
+     */
+    explicit ChunkScheduler(size_t nWorkers) : slices_(nWorkers == 0 ? 1 : nWorkers) {
+        reset(0);
+    }
+
+    /**
+     * @brief Starts a new round with `nChunks` chunks. Must not run concurrently with `next`.
+     *
+     * @param nChunks Number of chunks to distribute.
+     */
+    void reset(size_t nChunks) noexcept {
+        const size_t n = slices_.size();
+        for (size_t w = 0; w < n; ++w) {
+            slices_[w].next.store(nChunks * w / n, std::memory_order_relaxed);
+            slices_[w].end = nChunks * (w + 1) / n;
+        }
+    }
+
+    /**
+     * @brief Claims the next chunk for a worker.
+     *
+     * @param worker Index of the calling worker.
+     * @param chunk Receives the claimed chunk index.
+     * @return `true` if a chunk was claimed, `false` once every chunk has been handed out.
+     */
+    bool next(size_t worker, size_t& chunk) noexcept {
+        const size_t n = slices_.size();
+        for (size_t i = 0; i < n; ++i) {
+            Slice& slice = slices_[(worker + i) % n];
+            if (slice.next.load(std::memory_order_relaxed) >= slice.end) {
+                continue;
+            }
+            size_t claimed = slice.next.fetch_add(1, std::memory_order_relaxed);
+            if (claimed < slice.end) {
+                chunk = claimed;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Runs `fn(worker)` on a team of `nThreads` threads and waits for all of them.
+ *
+ * The calling thread takes part as worker 0, so `nThreads - 1` threads are spawned.
+ * `fn` must not throw.
+ *
+ * @tparam Fn Callable taking the worker index.
+ * @param nThreads Number of workers in the team.
+ * @param fn Function executed by every worker.
+ */
+template <typename Fn>
+void runTeam(size_t nThreads, Fn fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads > 0 ? nThreads - 1 : 0);
+    for (size_t w = 1; w < nThreads; ++w) {
+        threads.emplace_back([&fn, w]() { fn(w); });
+    }
+    fn(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace parallel
+} // namespace vpr
+
+#endif // WORK_STEALING_HPP
@@ -0,0 +1,221 @@
+#ifndef CANONICAL_HPP
+#define CANONICAL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Value hasher ignoring node values, so that only the shape of the trees is compared.
+ */
+struct IgnoreValues {
+    template <typename T>
+    size_t operator()(const T&) const noexcept { return 0; }
+};
+
+namespace detail {
+
+/**
+ * @brief SplitMix64 finalizer, used to spread child hashes before summing them.
+ */
+inline uint64_t mixHash(uint64_t x) noexcept {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Hash of a sequence of indices, used as the key hasher of the canonical dictionary.
+ */
+struct SequenceHash {
+    size_t operator()(const std::vector<size_t>& sequence) const noexcept {
+        uint64_t hash = sequence.size();
+        for (size_t value : sequence) {
+            hash = mixHash(hash ^ value);
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Computes a 64-bit structural hash of every subtree in one bottom-up pass.
+ *
+ * The hash of a node combines the hash of its value with the sum of the mixed hashes of its
+ * children, so it does not depend on the order of the children. Equal hashes do not prove
+ * equality, but unequal hashes prove the subtrees differ; use `CanonicalDictionary` for an
+ * exact answer.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ * @tparam ValueHash Callable hashing a node value, `IgnoreValues` to hash the shape only.
+ * @param tree The tree to hash.
+ * @param valueHash The value hasher.
+ * @return The hash of the subtree of every node, 0 for removed nodes.
+ */
+template <typename TreeType, typename ValueHash = IgnoreValues>
+std::vector<uint64_t> subtreeHashes(const TreeType& tree, ValueHash valueHash = ValueHash()) {
+    const size_t n = tree.size();
+    std::vector<uint64_t> hashes(n, 0);
+    // Nodes are stored after their parent, so a reverse sweep visits children first.
+    for (size_t node = n; node-- > 0;) {
+        if (tree.isRemoved(node)) {
+            continue;
+        }
+        const auto& current = tree.getNode(node);
+        uint64_t sum = 0;
+        for (size_t child : current.edges()) {
+            sum += detail::mixHash(hashes[child]);
+        }
+        hashes[node] = detail::mixHash(sum ^ detail::mixHash(static_cast<uint64_t>(valueHash(current.value()))));
+    }
+    return hashes;
+}
+
+/**
+ * @brief Dictionary assigning AHU canonical identifiers to subtrees.
+ *
+ * Two subtrees receive the same identifier if and only if they are isomorphic as unordered
+ * rooted trees and their nodes have equal value hashes. The dictionary is meant to be shared:
+ * identifiers computed for different trees with the same dictionary are directly comparable,
+ * so a stream of trees can be deduplicated by comparing the identifiers of their roots.
+ *
+ * Each tree is processed in one bottom-up pass; every node costs a dictionary lookup on the
+ * sorted identifiers of its children, i.e. O(n log d) overall for a maximum degree `d`.
+ *
+ * @tparam ValueHash Callable hashing a node value, `IgnoreValues` to compare shapes only.
+ */
+template <typename ValueHash = IgnoreValues>
+class CanonicalDictionary {
+
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    ValueHash valueHash_;
+    std::unordered_map<std::vector<size_t>, size_t, detail::SequenceHash> ids_;
+    std::vector<size_t> key_; ///< Scratch key, reused to avoid an allocation per lookup.
+
+public:
+
+    /**
+     * @brief Constructs an empty dictionary.
+     *
+     * @param valueHash The value hasher.
+     */
+    explicit CanonicalDictionary(ValueHash valueHash = ValueHash()) : valueHash_(valueHash) {}
+
+    /**
+     * @brief Returns the number of distinct subtrees seen so far.
+     *
+     * @return The number of canonical identifiers assigned.
+     */
+    inline size_t size() const noexcept { return ids_.size(); }
+
+    /**
+     * @brief Clears the dictionary, invalidating all identifiers handed out.
+     */
+    void clear() { ids_.clear(); }
+
+    /**
+     * @brief Computes the canonical identifier of every subtree of a tree.
+     *
+     * @tparam TreeType The type of the tree.
+     * @param tree The tree.
+     * @return The identifier of the subtree of every node, `static_cast<size_t>(-1)` for removed nodes.
+     */
+    template <typename TreeType>
+    std::vector<size_t> canonicalIds(const TreeType& tree) {
+        const size_t n = tree.size();
+        std::vector<size_t> ids(n, NONE);
+        for (size_t node = n; node-- > 0;) {
+            if (tree.isRemoved(node)) {
+                continue;
+            }
+            const auto& current = tree.getNode(node);
+            key_.clear();
+            for (size_t child : current.edges()) {
+                key_.push_back(ids[child]);
+            }
+            std::sort(key_.begin(), key_.end());
+            key_.push_back(static_cast<size_t>(valueHash_(current.value())));
+            auto it = ids_.find(key_);
+            if (it == ids_.end()) {
+                it = ids_.emplace(key_, ids_.size()).first;
+            }
+            ids[node] = it->second;
+        }
+        return ids;
+    }
+
+    /**
+     * @brief Computes the canonical identifier of a whole tree.
+     *
+     * @tparam TreeType The type of the tree.
+     * @param tree The tree.
+     * @return The identifier of the root, `static_cast<size_t>(-1)` for an empty tree.
+     */
+    template <typename TreeType>
+    size_t canonicalId(const TreeType& tree) {
+        return tree.size() == 0 ? NONE : canonicalIds(tree)[0];
+    }
+};
+
+template <typename ValueHash>
+constexpr size_t CanonicalDictionary<ValueHash>::NONE;
+
+/**
+ * @brief Tests whether two trees are isomorphic as unordered rooted trees.
+ *
+ * @tparam TreeType The type of the trees.
+ * @tparam ValueHash Callable hashing a node value, `IgnoreValues` to compare shapes only.
+ * @param first The first tree.
+ * @param second The second tree.
+ * @param valueHash The value hasher.
+ * @return True if the trees are isomorphic and matching nodes have equal value hashes.
+ */
+template <typename TreeType, typename ValueHash = IgnoreValues>
+bool isIsomorphic(const TreeType& first, const TreeType& second, ValueHash valueHash = ValueHash()) {
+    if (first.liveSize() != second.liveSize()) {
+        return false;
+    }
+    CanonicalDictionary<ValueHash> dictionary(valueHash);
+    return dictionary.canonicalId(first) == dictionary.canonicalId(second);
+}
+
+/**
+ * @brief Finds, for every node, the first node whose subtree is identical to its own.
+ *
+ * Nodes mapped to themselves are the distinct subtrees; every other node can be replaced by
+ * a reference to its representative.
+ *
+ * @tparam TreeType The type of the tree.
+ * @tparam ValueHash Callable hashing a node value, `IgnoreValues` to compare shapes only.
+ * @param tree The tree.
+ * @param valueHash The value hasher.
+ * @return The representative of every node, `static_cast<size_t>(-1)` for removed nodes.
+ */
+template <typename TreeType, typename ValueHash = IgnoreValues>
+std::vector<size_t> dedupSubtrees(const TreeType& tree, ValueHash valueHash = ValueHash()) {
+    CanonicalDictionary<ValueHash> dictionary(valueHash);
+    std::vector<size_t> ids = dictionary.canonicalIds(tree);
+    std::vector<size_t> representative(dictionary.size(), static_cast<size_t>(-1));
+    for (size_t node = 0; node < ids.size(); ++node) {
+        if (ids[node] == static_cast<size_t>(-1)) {
+            continue;
+        }
+        if (representative[ids[node]] == static_cast<size_t>(-1)) {
+            representative[ids[node]] = node;
+        }
+        ids[node] = representative[ids[node]];
+    }
+    return ids;
+}
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // CANONICAL_HPP
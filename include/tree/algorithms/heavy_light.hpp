@@ -0,0 +1,334 @@
+#ifndef HEAVY_LIGHT_HPP
+#define HEAVY_LIGHT_HPP
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "segment_tree.hpp"
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Heavy-light decomposition of a tree.
+ *
+ * Every node continues the chain of its parent when it has the largest subtree among its
+ * siblings (the heavy child). Nodes are then numbered by a DFS visiting the heavy child first,
+ * so every chain, and every subtree, occupies a contiguous range of positions. Any path
+ * crosses O(log n) light edges and therefore splits into O(log n) position ranges, which can
+ * be fed to a range-aggregate structure indexed by position, such as `SegmentTree`.
+ *
+ * The decomposition is a snapshot: it must be rebuilt after the tree is modified. Removed
+ * nodes are not given a position and cannot be queried.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ */
+template <typename TreeType>
+class HeavyLightDecomposition {
+
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+public:
+
+    /**
+     * @brief Half-open range of positions `[begin, end)`.
+     */
+    struct Range {
+        size_t begin; ///< First position of the range.
+        size_t end;   ///< One past the last position of the range.
+    };
+
+private:
+
+    std::vector<size_t> parent_;   ///< Parent of every node, the root being its own parent.
+    std::vector<size_t> depth_;    ///< Depth of every node, `NONE` for removed nodes.
+    std::vector<size_t> size_;     ///< Number of nodes in the subtree of every node.
+    std::vector<size_t> head_;     ///< Topmost node of the chain of every node.
+    std::vector<size_t> position_; ///< Position of every node.
+    std::vector<size_t> node_;     ///< Node at every position.
+
+public:
+
+    /**
+     * @brief Builds the decomposition of a tree.
+     *
+     * @param tree The tree to decompose.
+     */
+    explicit HeavyLightDecomposition(const TreeType& tree)
+        : parent_(tree.size(), 0), depth_(tree.size(), NONE), size_(tree.size(), 0),
+          head_(tree.size(), NONE), position_(tree.size(), NONE) {
+        const size_t n = tree.size();
+        if (n == 0) {
+            return;
+        }
+
+        // Subtree sizes and heavy children. Nodes are stored after their parent, so a reverse
+        // sweep visits every child before its parent.
+        std::vector<size_t> heavy(n, NONE);
+        for (size_t node = 0; node < n; ++node) {
+            if (tree.isRemoved(node)) {
+                continue;
+            }
+            parent_[node] = node == 0 ? 0 : tree.getNode(node).parentId();
+            depth_[node] = tree.depth(node);
+            size_[node] = 1;
+        }
+        for (size_t node = n; node-- > 1;) {
+            if (depth_[node] == NONE) {
+                continue;
+            }
+            size_t p = parent_[node];
+            size_[p] += size_[node];
+            if (heavy[p] == NONE || size_[node] > size_[heavy[p]]) {
+                heavy[p] = node;
+            }
+        }
+
+        // Heavy-first DFS: the heavy child is pushed last so it is numbered right after its parent.
+        node_.reserve(size_[0]);
+        std::vector<size_t> stack(1, 0);
+        head_[0] = 0;
+        while (!stack.empty()) {
+            size_t node = stack.back();
+            stack.pop_back();
+            position_[node] = node_.size();
+            node_.push_back(node);
+            for (size_t child : tree.getNode(node).edges()) {
+                if (child != heavy[node]) {
+                    head_[child] = child;
+                    stack.push_back(child);
+                }
+            }
+            if (heavy[node] != NONE) {
+                head_[heavy[node]] = head_[node];
+                stack.push_back(heavy[node]);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of positions, i.e. the number of live nodes.
+     *
+     * @return The number of positions.
+     */
+    inline size_t size() const noexcept { return node_.size(); }
+
+    /**
+     * @brief Returns the position of a node.
+     *
+     * @param node The index of the node.
+     * @return The position of the node.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    size_t position(size_t node) const {
+        validate(node);
+        return position_[node];
+    }
+
+    /**
+     * @brief Returns the node at a position.
+     *
+     * @param position The position.
+     * @return The index of the node.
+     * @throw std::out_of_range If the position is invalid.
+     */
+    size_t nodeAt(size_t position) const {
+        if (position >= node_.size()) {
+            throw std::out_of_range("Invalid position.");
+        }
+        return node_[position];
+    }
+
+    /**
+     * @brief Returns the topmost node of the heavy chain containing a node.
+     *
+     * @param node The index of the node.
+     * @return The index of the chain head.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    size_t chainHead(size_t node) const {
+        validate(node);
+        return head_[node];
+    }
+
+    /**
+     * @brief Returns the range of positions covered by the subtree of a node.
+     *
+     * @param node The index of the node.
+     * @return The positions of the node and all its descendants.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    Range subtreeRange(size_t node) const {
+        validate(node);
+        return Range{position_[node], position_[node] + size_[node]};
+    }
+
+    /**
+     * @brief Calls `fn(range)` for every range of positions on the path between two nodes.
+     *
+     * Both endpoints are included. The ranges are disjoint but are not reported in path order.
+     *
+     * @param u The index of the first node.
+     * @param v The index of the second node.
+     * @param fn Callable invoked with a `Range`.
+     * @return The lowest common ancestor of `u` and `v`.
+     * @throw std::out_of_range If either node is invalid or removed.
+     */
+    template <typename Fn>
+    size_t forEachPathRange(size_t u, size_t v, Fn fn) const {
+        validate(u);
+        validate(v);
+        while (head_[u] != head_[v]) {
+            if (depth_[head_[u]] < depth_[head_[v]]) {
+                std::swap(u, v);
+            }
+            fn(Range{position_[head_[u]], position_[u] + 1});
+            u = parent_[head_[u]];
+        }
+        if (position_[u] > position_[v]) {
+            std::swap(u, v);
+        }
+        fn(Range{position_[u], position_[v] + 1});
+        return u;
+    }
+
+    /**
+     * @brief Returns the ranges of positions on the path between two nodes, both included.
+     *
+     * @param u The index of the first node.
+     * @param v The index of the second node.
+     * @return At most O(log n) disjoint ranges.
+     * @throw std::out_of_range If either node is invalid or removed.
+     */
+    std::vector<Range> pathRanges(size_t u, size_t v) const {
+        std::vector<Range> ranges;
+        forEachPathRange(u, v, [&ranges](const Range& range) { ranges.push_back(range); });
+        return ranges;
+    }
+
+    /**
+     * @brief Returns the ranges of positions on the path from the root to a node.
+     *
+     * @param node The index of the node.
+     * @return At most O(log n) disjoint ranges.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    std::vector<Range> rootPathRanges(size_t node) const {
+        return node_.empty() ? std::vector<Range>() : pathRanges(0, node);
+    }
+
+    /**
+     * @brief Returns the lowest common ancestor of two nodes in O(log n).
+     *
+     * @param u The index of the first node.
+     * @param v The index of the second node.
+     * @return The index of the lowest common ancestor.
+     * @throw std::out_of_range If either node is invalid or removed.
+     */
+    size_t lca(size_t u, size_t v) const {
+        return forEachPathRange(u, v, [](const Range&) {});
+    }
+
+private:
+
+    void validate(size_t node) const {
+        if (node >= depth_.size() || depth_[node] == NONE) {
+            throw std::out_of_range("Invalid node index.");
+        }
+    }
+};
+
+template <typename TreeType>
+constexpr size_t HeavyLightDecomposition<TreeType>::NONE;
+
+/**
+ * @brief Per-node values aggregated along tree paths and over subtrees in O(log^2 n).
+ *
+ * Combines a `HeavyLightDecomposition` with a `SegmentTree` indexed by position. Since the
+ * ranges of a path are not combined in path order, `Combine` must be commutative as well as
+ * associative (sum, min, max, xor...).
+ *
+ * @tparam TreeType The type of the tree.
+ * @tparam T The type of the aggregated values.
+ * @tparam Combine Commutative and associative binary operation, `std::plus<T>` by default.
+ */
+template <typename TreeType, typename T, typename Combine = std::plus<T>>
+class PathAggregate {
+
+    HeavyLightDecomposition<TreeType> decomposition_;
+    SegmentTree<T, Combine> values_;
+    T identity_;
+    Combine combine_;
+
+public:
+
+    /**
+     * @brief Decomposes a tree and sets the value of every node to `identity`.
+     *
+     * @param tree The tree to index.
+     * @param identity Neutral element of `combine`.
+     * @param combine Aggregation operation.
+     */
+    explicit PathAggregate(const TreeType& tree, T identity = T(), Combine combine = Combine())
+        : decomposition_(tree), values_(decomposition_.size(), identity, combine),
+          identity_(identity), combine_(combine) {}
+
+    /**
+     * @brief Returns the underlying decomposition.
+     *
+     * @return The heavy-light decomposition.
+     */
+    inline const HeavyLightDecomposition<TreeType>& decomposition() const noexcept { return decomposition_; }
+
+    /**
+     * @brief Returns the value of a node.
+     *
+     * @param node The index of the node.
+     * @return The value of the node.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    const T& get(size_t node) const { return values_.get(decomposition_.position(node)); }
+
+    /**
+     * @brief Sets the value of a node in O(log n).
+     *
+     * @param node The index of the node.
+     * @param value The new value.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    void set(size_t node, T value) { values_.set(decomposition_.position(node), std::move(value)); }
+
+    /**
+     * @brief Aggregates the values on the path between two nodes, both included.
+     *
+     * @param u The index of the first node.
+     * @param v The index of the second node.
+     * @return The aggregate of the path.
+     * @throw std::out_of_range If either node is invalid or removed.
+     */
+    T pathQuery(size_t u, size_t v) const {
+        T result = identity_;
+        decomposition_.forEachPathRange(u, v, [this, &result](const typename HeavyLightDecomposition<TreeType>::Range& range) {
+            result = combine_(result, values_.query(range.begin, range.end));
+        });
+        return result;
+    }
+
+    /**
+     * @brief Aggregates the values in the subtree of a node in O(log n).
+     *
+     * @param node The index of the node.
+     * @return The aggregate of the subtree.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    T subtreeQuery(size_t node) const {
+        typename HeavyLightDecomposition<TreeType>::Range range = decomposition_.subtreeRange(node);
+        return values_.query(range.begin, range.end);
+    }
+};
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // HEAVY_LIGHT_HPP
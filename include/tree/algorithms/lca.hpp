@@ -0,0 +1,254 @@
+#ifndef LCA_HPP
+#define LCA_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Data structures available to answer lowest-common-ancestor queries.
+ */
+enum class LcaStrategy {
+    EulerTour,    ///< DFS order plus sparse table: O(n log n) build, O(1) queries.
+    BinaryLifting ///< Jump pointers: O(n log n) build with half the memory, O(log n) queries.
+};
+
+/**
+ * @brief Index answering lowest-common-ancestor queries over a tree.
+ *
+ * The index is a snapshot: it must be rebuilt after the tree is modified. Nodes removed
+ * from the tree are not indexed and cannot be queried.
+ *
+ * With `LcaStrategy::EulerTour` the nodes are laid out in DFS order and a sparse table keeps,
+ * for every power-of-two window of that order, the shallowest node. For two distinct nodes
+ * `u` and `v` with `u` visited first, the shallowest node visited after `u` and up to `v` is a
+ * child of their LCA, so a query is two table lookups and one `parentId()`. This variant of the
+ * Euler tour technique only needs `n` entries per table level instead of `2n - 1`.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ */
+template <typename TreeType>
+class LowestCommonAncestor {
+
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    LcaStrategy strategy_;            ///< Data structure used to answer queries.
+    std::vector<size_t> parent_;      ///< Parent of every node, the root being its own parent.
+    std::vector<size_t> depth_;       ///< Depth of every node, `NONE` for removed nodes.
+    std::vector<size_t> order_;       ///< Position of every node in DFS order (Euler tour only).
+    std::vector<size_t> log2_;        ///< Floor of log2 for every window length (Euler tour only).
+    std::vector<std::vector<size_t>> table_; ///< Sparse table or jump pointers, one row per power of two.
+
+public:
+
+    /**
+     * @brief Builds the index over a tree.
+     *
+     * @param tree The tree to index.
+     * @param strategy The data structure used to answer queries.
+     */
+    explicit LowestCommonAncestor(const TreeType& tree, LcaStrategy strategy = LcaStrategy::EulerTour)
+        : strategy_(strategy), parent_(tree.size()), depth_(tree.size(), NONE) {
+        if (strategy_ == LcaStrategy::EulerTour) {
+            buildSparseTable(traverse(tree));
+        } else {
+            buildJumpPointers(tree);
+        }
+    }
+
+    /**
+     * @brief Returns the strategy used by the index.
+     *
+     * @return The LCA strategy.
+     */
+    inline LcaStrategy strategy() const noexcept { return strategy_; }
+
+    /**
+     * @brief Returns the depth of a node, the root having depth 0.
+     *
+     * @param node The index of the node.
+     * @return The depth of the node.
+     * @throw std::out_of_range If the node is invalid or removed.
+     */
+    size_t depth(size_t node) const {
+        validate(node);
+        return depth_[node];
+    }
+
+    /**
+     * @brief Returns the lowest common ancestor of two nodes.
+     *
+     * A node is considered an ancestor of itself.
+     *
+     * @param u The index of the first node.
+     * @param v The index of the second node.
+     * @return The index of the deepest node that is an ancestor of both.
+     * @throw std::out_of_range If either node is invalid or removed.
+     */
+    size_t query(size_t u, size_t v) const {
+        validate(u);
+        validate(v);
+        return strategy_ == LcaStrategy::EulerTour ? querySparseTable(u, v) : queryJumpPointers(u, v);
+    }
+
+    /**
+     * @brief Answers a batch of queries.
+     *
+     * @param pairs The pairs of node indices to query.
+     * @return The lowest common ancestor of every pair, in the same order.
+     * @throw std::out_of_range If any node is invalid or removed.
+     */
+    std::vector<size_t> query(const std::vector<std::pair<size_t, size_t>>& pairs) const {
+        std::vector<size_t> result;
+        result.reserve(pairs.size());
+        for (const auto& pair : pairs) {
+            result.push_back(query(pair.first, pair.second));
+        }
+        return result;
+    }
+
+private:
+
+    void validate(size_t node) const {
+        if (node >= depth_.size() || depth_[node] == NONE) {
+            throw std::out_of_range("Invalid node index.");
+        }
+    }
+
+    /**
+     * @brief Fills parents and depths and returns the nodes in DFS pre-order.
+     */
+    std::vector<size_t> traverse(const TreeType& tree) {
+        std::vector<size_t> preorder;
+        if (tree.size() == 0) {
+            return preorder;
+        }
+        preorder.reserve(tree.size());
+        std::vector<size_t> stack(1, 0);
+        parent_[0] = 0;
+        depth_[0] = 0;
+        while (!stack.empty()) {
+            size_t node = stack.back();
+            stack.pop_back();
+            preorder.push_back(node);
+            const auto& children = tree.getNode(node).edges();
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                parent_[*it] = node;
+                depth_[*it] = depth_[node] + 1;
+                stack.push_back(*it);
+            }
+        }
+        return preorder;
+    }
+
+    size_t shallower(size_t a, size_t b) const { return depth_[b] < depth_[a] ? b : a; }
+
+    void buildSparseTable(const std::vector<size_t>& preorder) {
+        const size_t n = preorder.size();
+        order_.assign(parent_.size(), NONE);
+        for (size_t i = 0; i < n; ++i) {
+            order_[preorder[i]] = i;
+        }
+        log2_.assign(n + 1, 0);
+        for (size_t i = 2; i <= n; ++i) {
+            log2_[i] = log2_[i / 2] + 1;
+        }
+
+        table_.assign(1, preorder);
+        for (size_t k = 1; (size_t(1) << k) <= n; ++k) {
+            const std::vector<size_t>& previous = table_[k - 1];
+            const size_t half = size_t(1) << (k - 1);
+            std::vector<size_t> row(n - (size_t(1) << k) + 1);
+            for (size_t i = 0; i < row.size(); ++i) {
+                row[i] = shallower(previous[i], previous[i + half]);
+            }
+            table_.push_back(std::move(row));
+        }
+    }
+
+    size_t querySparseTable(size_t u, size_t v) const {
+        if (u == v) {
+            return u;
+        }
+        size_t first = order_[u];
+        size_t last = order_[v];
+        if (first > last) {
+            std::swap(first, last);
+        }
+        ++first;
+        const size_t k = log2_[last - first + 1];
+        const size_t child = shallower(table_[k][first], table_[k][last + 1 - (size_t(1) << k)]);
+        return parent_[child];
+    }
+
+    /**
+     * @brief Builds the jump pointers with a single sweep over `parentId()`.
+     *
+     * Nodes are always stored after their parent, so one pass in index order is enough.
+     */
+    void buildJumpPointers(const TreeType& tree) {
+        const size_t n = tree.size();
+        size_t maxDepth = 0;
+        if (n != 0) {
+            parent_[0] = 0;
+            depth_[0] = 0;
+        }
+        for (size_t node = 1; node < n; ++node) {
+            if (tree.isRemoved(node)) {
+                parent_[node] = node;
+                continue;
+            }
+            parent_[node] = tree.getNode(node).parentId();
+            depth_[node] = depth_[parent_[node]] + 1;
+            maxDepth = std::max(maxDepth, depth_[node]);
+        }
+        size_t levels = 1;
+        while ((size_t(1) << levels) <= maxDepth) {
+            ++levels;
+        }
+
+        table_.assign(1, parent_);
+        for (size_t k = 1; k < levels; ++k) {
+            const std::vector<size_t>& previous = table_[k - 1];
+            std::vector<size_t> row(n);
+            for (size_t node = 0; node < n; ++node) {
+                row[node] = previous[previous[node]];
+            }
+            table_.push_back(std::move(row));
+        }
+    }
+
+    size_t queryJumpPointers(size_t u, size_t v) const {
+        if (depth_[u] < depth_[v]) {
+            std::swap(u, v);
+        }
+        size_t difference = depth_[u] - depth_[v];
+        for (size_t k = 0; difference != 0; ++k, difference >>= 1) {
+            if (difference & 1) {
+                u = table_[k][u];
+            }
+        }
+        if (u == v) {
+            return u;
+        }
+        for (size_t k = table_.size(); k-- > 0;) {
+            if (table_[k][u] != table_[k][v]) {
+                u = table_[k][u];
+                v = table_[k][v];
+            }
+        }
+        return parent_[u];
+    }
+};
+
+template <typename TreeType>
+constexpr size_t LowestCommonAncestor<TreeType>::NONE;
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // LCA_HPP
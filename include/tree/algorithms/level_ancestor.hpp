@@ -0,0 +1,155 @@
+#ifndef LEVEL_ANCESTOR_HPP
+#define LEVEL_ANCESTOR_HPP
+
+#include <stdexcept>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Index answering level-ancestor queries ("the ancestor k levels up") in O(1).
+ *
+ * Implements the jump-pointer + ladder algorithm. The tree is split into longest paths, and
+ * every path is stored as a ladder extended upwards by its own length. A query jumps with
+ * the largest power of two not exceeding `k`; the node reached has a subtree at least that
+ * high, so the remainder is always covered by its ladder and is one array lookup.
+ *
+ * The index uses O(n log n) memory for the jump pointers plus at most 2n ladder entries, and
+ * is built in O(n log n) from `parentId()` and `depth()`. It is a snapshot: it must be rebuilt
+ * after the tree is modified. Removed nodes cannot be queried.
+ *
+ * @tparam TreeType The type of the tree, e.g. `lightweight::Tree` or `smart::Tree`.
+ */
+template <typename TreeType>
+class LevelAncestor {
+
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    std::vector<size_t> depth_;              ///< Depth of every node, `NONE` for removed nodes.
+    std::vector<size_t> log2_;               ///< Floor of log2 for every level count up to the height.
+    std::vector<std::vector<size_t>> jump_;  ///< `jump_[i][v]` is the 2^i-th ancestor of `v`.
+    std::vector<size_t> ladders_;            ///< All ladders, each stored from its top to its bottom.
+    std::vector<size_t> position_;           ///< Position of every node in the ladder of its path.
+
+public:
+
+    /**
+     * @brief Builds the index over a tree.
+     *
+     * @param tree The tree to index.
+     */
+    explicit LevelAncestor(const TreeType& tree) : depth_(tree.size(), NONE), position_(tree.size(), NONE) {
+        const size_t n = tree.size();
+        if (n == 0) {
+            return;
+        }
+
+        // Parents, depths, heights and longest child. Nodes are stored after their parent,
+        // so a reverse sweep visits every child before its parent.
+        std::vector<size_t> parent(n, 0);
+        std::vector<size_t> height(n, 0);
+        std::vector<size_t> longest(n, NONE);
+        size_t maxDepth = 0;
+        for (size_t node = 0; node < n; ++node) {
+            if (tree.isRemoved(node)) {
+                parent[node] = node;
+                continue;
+            }
+            parent[node] = node == 0 ? 0 : tree.getNode(node).parentId();
+            depth_[node] = tree.depth(node);
+            maxDepth = depth_[node] > maxDepth ? depth_[node] : maxDepth;
+        }
+        for (size_t node = n; node-- > 1;) {
+            if (depth_[node] == NONE) {
+                continue;
+            }
+            size_t p = parent[node];
+            if (longest[p] == NONE || height[node] + 1 > height[p]) {
+                height[p] = height[node] + 1;
+                longest[p] = node;
+            }
+        }
+
+        // Ladders: every longest path, extended upwards by its length.
+        ladders_.reserve(2 * n);
+        std::vector<size_t> above;
+        for (size_t top = 0; top < n; ++top) {
+            if (depth_[top] == NONE || (top != 0 && longest[parent[top]] == top)) {
+                continue;
+            }
+            const size_t length = height[top] + 1;
+            above.clear();
+            for (size_t x = top; above.size() < length && x != 0;) {
+                x = parent[x];
+                above.push_back(x);
+            }
+            ladders_.insert(ladders_.end(), above.rbegin(), above.rend());
+            for (size_t x = top; x != NONE; x = longest[x]) {
+                position_[x] = ladders_.size();
+                ladders_.push_back(x);
+            }
+        }
+
+        // Jump pointers.
+        log2_.assign(maxDepth + 1, 0);
+        for (size_t i = 2; i <= maxDepth; ++i) {
+            log2_[i] = log2_[i / 2] + 1;
+        }
+        jump_.assign(1, parent);
+        for (size_t k = 1; (size_t(1) << k) <= maxDepth; ++k) {
+            const std::vector<size_t>& previous = jump_[k - 1];
+            std::vector<size_t> row(n);
+            for (size_t node = 0; node < n; ++node) {
+                row[node] = previous[previous[node]];
+            }
+            jump_.push_back(std::move(row));
+        }
+    }
+
+    /**
+     * @brief Returns the ancestor of a node `k` levels up.
+     *
+     * @param node The index of the node.
+     * @param k The number of levels to climb; 0 returns the node itself.
+     * @return The index of the ancestor.
+     * @throw std::out_of_range If the node is invalid or removed, or if `k` exceeds its depth.
+     */
+    size_t ancestor(size_t node, size_t k) const {
+        if (node >= depth_.size() || depth_[node] == NONE) {
+            throw std::out_of_range("Invalid node index.");
+        }
+        if (k > depth_[node]) {
+            throw std::out_of_range("Ancestor level exceeds the depth of the node.");
+        }
+        if (k == 0) {
+            return node;
+        }
+        const size_t level = log2_[k];
+        const size_t jumped = jump_[level][node];
+        return ladders_[position_[jumped] - (k - (size_t(1) << level))];
+    }
+
+    /**
+     * @brief Returns the ancestor of a node at a given depth.
+     *
+     * @param node The index of the node.
+     * @param depth The depth of the ancestor, at most the depth of the node.
+     * @return The index of the ancestor.
+     * @throw std::out_of_range If the node is invalid or removed, or if `depth` exceeds its depth.
+     */
+    size_t ancestorAtDepth(size_t node, size_t depth) const {
+        if (node >= depth_.size() || depth_[node] == NONE || depth > depth_[node]) {
+            throw std::out_of_range("Invalid node index or depth.");
+        }
+        return ancestor(node, depth_[node] - depth);
+    }
+};
+
+template <typename TreeType>
+constexpr size_t LevelAncestor<TreeType>::NONE;
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // LEVEL_ANCESTOR_HPP
@@ -0,0 +1,108 @@
+#ifndef SEGMENT_TREE_HPP
+#define SEGMENT_TREE_HPP
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace vpr {
+namespace algorithms {
+
+/**
+ * @brief Iterative segment tree answering range aggregates with point updates.
+ *
+ * Both operations run in O(log n). `Combine` must be associative and `identity` must be its
+ * neutral element.
+ *
+ * @tparam T The type of the aggregated values.
+ * @tparam Combine Associative binary operation, `std::plus<T>` by default.
+ */
+template <typename T, typename Combine = std::plus<T>>
+class SegmentTree {
+
+    size_t size_;          ///< Number of positions.
+    T identity_;           ///< Neutral element of `combine_`.
+    Combine combine_;      ///< Aggregation operation.
+    std::vector<T> tree_;  ///< Leaves in `[size_, 2 * size_)`, internal nodes below.
+
+public:
+
+    /**
+     * @brief Constructs a segment tree with every position set to `identity`.
+     *
+     * @param size Number of positions.
+     * @param identity Neutral element of `combine`.
+     * @param combine Aggregation operation.
+     */
+    explicit SegmentTree(size_t size, T identity = T(), Combine combine = Combine())
+        : size_(size), identity_(identity), combine_(combine), tree_(2 * size, identity) {}
+
+    /**
+     * @brief Returns the number of positions.
+     *
+     * @return The size of the segment tree.
+     */
+    inline size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Returns the value stored at a position.
+     *
+     * @param position The position.
+     * @return The value at that position.
+     * @throw std::out_of_range If the position is invalid.
+     */
+    const T& get(size_t position) const {
+        if (position >= size_) {
+            throw std::out_of_range("Invalid position.");
+        }
+        return tree_[size_ + position];
+    }
+
+    /**
+     * @brief Replaces the value stored at a position.
+     *
+     * @param position The position.
+     * @param value The new value.
+     * @throw std::out_of_range If the position is invalid.
+     */
+    void set(size_t position, T value) {
+        if (position >= size_) {
+            throw std::out_of_range("Invalid position.");
+        }
+        position += size_;
+        tree_[position] = std::move(value);
+        for (position /= 2; position >= 1; position /= 2) {
+            tree_[position] = combine_(tree_[2 * position], tree_[2 * position + 1]);
+        }
+    }
+
+    /**
+     * @brief Aggregates the values of the positions in `[begin, end)`, in position order.
+     *
+     * @param begin First position of the range.
+     * @param end One past the last position of the range.
+     * @return The aggregate, or `identity` for an empty range.
+     * @throw std::out_of_range If the range is invalid.
+     */
+    T query(size_t begin, size_t end) const {
+        if (begin > end || end > size_) {
+            throw std::out_of_range("Invalid range.");
+        }
+        T left = identity_;
+        T right = identity_;
+        for (begin += size_, end += size_; begin < end; begin /= 2, end /= 2) {
+            if (begin & 1) {
+                left = combine_(left, tree_[begin++]);
+            }
+            if (end & 1) {
+                right = combine_(tree_[--end], right);
+            }
+        }
+        return combine_(left, right);
+    }
+};
+
+} // namespace algorithms
+} // namespace vpr
+
+#endif // SEGMENT_TREE_HPP
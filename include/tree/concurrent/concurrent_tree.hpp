@@ -0,0 +1,358 @@
+#ifndef CONCURRENT_TREE_HPP
+#define CONCURRENT_TREE_HPP
+
+#include <atomic>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "lightweight_tree.hpp"
+
+namespace vpr {
+namespace concurrent {
+
+/**
+ * @brief An append-only tree accepting `addChild` calls from many threads at once.
+ *
+ * Node indices are reserved with a single atomic increment. Nodes live in segments of
+ * doubling size that are never moved, so a node keeps its address while the tree grows and
+ * readers need no lock. Children are kept in lock-free singly linked lists: a new child is
+ * pushed at the front of its parent's list with a compare-and-swap, after the node has been
+ * fully constructed, so a reader following the links only ever sees complete nodes.
+ *
+ * As with the other trees, the root is node 0 and a child always has a larger index than
+ * its parent. Children are listed from the most recent to the oldest; `toTree()` converts
+ * the tree, once writers are done, into a `lightweight::Tree` with the same indices.
+ *
+ * @tparam T The type of the value stored in each node. Its move constructor must not throw.
+ */
+template <typename T>
+class Tree {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "Values of a concurrent tree must be nothrow move constructible.");
+
+public:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+private:
+
+    struct Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; ///< The value, once constructed.
+        size_t parent;                   ///< Index of the parent, 0 for the root.
+        size_t depth;                    ///< Depth of the node.
+        std::atomic<size_t> firstChild;  ///< Most recent child, `NONE` if there is none.
+        std::atomic<size_t> nextSibling; ///< Next older sibling, `NONE` if there is none.
+        std::atomic<size_t> childCount;  ///< Number of children.
+        std::atomic<bool> ready;         ///< Whether the node is constructed.
+
+        T& value() noexcept { return *reinterpret_cast<T*>(&storage); }
+        const T& value() const noexcept { return *reinterpret_cast<const T*>(&storage); }
+    };
+
+    static constexpr size_t FIRST_SEGMENT_BITS = 6;
+    static constexpr size_t MAX_SEGMENTS = 64 - FIRST_SEGMENT_BITS;
+
+    std::atomic<Slot*> segments_[MAX_SEGMENTS]; ///< Segment `k` holds `64 << k` nodes.
+    std::atomic<size_t> next_;                   ///< Next index to reserve.
+
+    static size_t highestBit(size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+        size_t bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static size_t segmentOf(size_t index) noexcept {
+        return highestBit(index + (size_t(1) << FIRST_SEGMENT_BITS)) - FIRST_SEGMENT_BITS;
+    }
+
+    static size_t segmentSize(size_t segment) noexcept {
+        return size_t(1) << (segment + FIRST_SEGMENT_BITS);
+    }
+
+    /**
+     * @brief Returns the segment of an index, allocating it if needed.
+     *
+     * Threads racing to allocate the same segment publish it with a compare-and-swap; the
+     * losers free their copy.
+     */
+    Slot* segment(size_t k) {
+        Slot* current = segments_[k].load(std::memory_order_acquire);
+        if (current != nullptr) {
+            return current;
+        }
+        Slot* fresh = new Slot[segmentSize(k)]();
+        if (segments_[k].compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+            return fresh;
+        }
+        delete[] fresh;
+        return current;
+    }
+
+    Slot& slot(size_t index) noexcept {
+        const size_t k = segmentOf(index);
+        return segments_[k].load(std::memory_order_acquire)[index + segmentSize(0) - segmentSize(k)];
+    }
+
+    const Slot& slot(size_t index) const noexcept {
+        return const_cast<Tree*>(this)->slot(index);
+    }
+
+    /**
+     * @brief Returns the storage of a published node, or `nullptr` if there is none.
+     */
+    const Slot* publishedSlot(size_t index) const noexcept {
+        if (index >= next_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        const size_t k = segmentOf(index);
+        const Slot* first = segments_[k].load(std::memory_order_acquire);
+        if (first == nullptr) {
+            return nullptr;
+        }
+        const Slot* s = first + (index + segmentSize(0) - segmentSize(k));
+        return s->ready.load(std::memory_order_acquire) ? s : nullptr;
+    }
+
+    const Slot& readySlot(size_t index) const {
+        const Slot* s = publishedSlot(index);
+        if (s == nullptr) {
+            throw std::out_of_range("Invalid node index.");
+        }
+        return *s;
+    }
+
+    size_t emplace(size_t parent, size_t depth, T&& value) {
+        const size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+        const size_t k = segmentOf(index);
+        if (k >= MAX_SEGMENTS) {
+            throw std::length_error("Concurrent tree is full.");
+        }
+        Slot& s = segment(k)[index + segmentSize(0) - segmentSize(k)];
+        new (&s.storage) T(std::move(value));
+        s.parent = parent;
+        s.depth = depth;
+        s.firstChild.store(NONE, std::memory_order_relaxed);
+        s.nextSibling.store(NONE, std::memory_order_relaxed);
+        s.childCount.store(0, std::memory_order_relaxed);
+        s.ready.store(true, std::memory_order_release);
+        return index;
+    }
+
+public:
+
+    /**
+     * @brief Forward iterator over the children of a node, following the sibling links.
+     */
+    class ChildIterator {
+
+        const Tree* tree_; ///< Tree being traversed.
+        size_t current_;   ///< Index of the current child, `NONE` at the end.
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = const size_t&;
+
+        ChildIterator(const Tree* tree, size_t current) : tree_(tree), current_(current) {}
+
+        reference operator*() const { return current_; }
+
+        ChildIterator& operator++() {
+            current_ = tree_->slot(current_).nextSibling.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        ChildIterator operator++(int) {
+            ChildIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const ChildIterator& other) const { return current_ == other.current_; }
+        bool operator!=(const ChildIterator& other) const { return current_ != other.current_; }
+    };
+
+    /**
+     * @brief Snapshot of the children list of a node, taken when the range is created.
+     */
+    class ChildRange {
+
+        const Tree* tree_; ///< Tree being traversed.
+        size_t first_;     ///< Most recent child when the range was created.
+
+    public:
+        ChildRange(const Tree* tree, size_t first) : tree_(tree), first_(first) {}
+
+        ChildIterator begin() const { return ChildIterator(tree_, first_); }
+        ChildIterator end() const { return ChildIterator(tree_, NONE); }
+        bool empty() const noexcept { return first_ == NONE; }
+    };
+
+    /**
+     * @brief Read-only view of a published node.
+     */
+    class Node {
+
+        const Tree* tree_; ///< Owning tree.
+        size_t index_;     ///< Index of the node.
+        const Slot* slot_; ///< Storage of the node.
+
+    public:
+        using DataType = T;
+
+        Node(const Tree* tree, size_t index, const Slot* slot) : tree_(tree), index_(index), slot_(slot) {}
+
+        size_t index() const noexcept { return index_; }
+        size_t parentId() const noexcept { return slot_->parent; }
+        size_t depth() const noexcept { return slot_->depth; }
+        bool isRoot() const noexcept { return index_ == 0; }
+        const T& value() const noexcept { return slot_->value(); }
+        const T& operator*() const noexcept { return value(); }
+        const T* operator->() const noexcept { return &value(); }
+
+        /**
+         * @brief Returns the number of children published so far.
+         */
+        size_t nChildren() const noexcept { return slot_->childCount.load(std::memory_order_acquire); }
+        bool isLeaf() const noexcept { return children().empty(); }
+
+        /**
+         * @brief Returns the children published so far, from the most recent to the oldest.
+         */
+        ChildRange children() const {
+            return ChildRange(tree_, slot_->firstChild.load(std::memory_order_acquire));
+        }
+    };
+
+    /**
+     * @brief Constructs a tree with a root value.
+     *
+     * @param root The value of the root node.
+     * @param initial_capacity Number of nodes for which storage is allocated up front.
+     */
+    explicit Tree(T root, size_t initial_capacity = 64) : next_(0) {
+        for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+            segments_[k].store(nullptr, std::memory_order_relaxed);
+        }
+        reserve(initial_capacity);
+        emplace(0, 0, std::move(root));
+    }
+
+    Tree(const Tree&) = delete;
+    Tree& operator=(const Tree&) = delete;
+
+    /**
+     * @brief Destroys the values and frees the segments. No thread may use the tree anymore.
+     */
+    ~Tree() {
+        const size_t n = next_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n; ++i) {
+            const Slot* s = publishedSlot(i);
+            if (s != nullptr) {
+                const_cast<Slot*>(s)->value().~T();
+            }
+        }
+        for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+            delete[] segments_[k].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Allocates the segments needed to hold `capacity` nodes, so that later insertions
+     * do not allocate. Safe to call concurrently with any other method.
+     *
+     * @param capacity The number of nodes.
+     */
+    void reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        for (size_t k = 0; k <= segmentOf(capacity - 1); ++k) {
+            segment(k);
+        }
+    }
+
+    /**
+     * @brief Adds a child to a node. Safe to call from many threads at once.
+     *
+     * Runs in O(1) apart from segment allocation, which happens once per doubling of the tree
+     * unless storage was reserved. The child becomes visible to readers of its parent's
+     * children once this method returns.
+     *
+     * @param parent_index The index of the parent, which must have been published.
+     * @param value The value of the child.
+     * @return The index of the new child.
+     * @throw std::out_of_range If the parent index is invalid.
+     */
+    size_t addChild(size_t parent_index, T value) {
+        Slot& parent = const_cast<Slot&>(readySlot(parent_index));
+        const size_t index = emplace(parent_index, parent.depth + 1, std::move(value));
+        Slot& child = slot(index);
+        size_t head = parent.firstChild.load(std::memory_order_relaxed);
+        do {
+            child.nextSibling.store(head, std::memory_order_relaxed);
+        } while (!parent.firstChild.compare_exchange_weak(head, index, std::memory_order_release,
+                                                          std::memory_order_relaxed));
+        parent.childCount.fetch_add(1, std::memory_order_release);
+        return index;
+    }
+
+    /**
+     * @brief Returns the number of reserved indices, an upper bound on the published nodes.
+     */
+    inline size_t size() const noexcept { return next_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Checks whether a node is published and can be read.
+     */
+    bool isPublished(size_t index) const noexcept { return publishedSlot(index) != nullptr; }
+
+    /**
+     * @brief Returns a view of a published node.
+     *
+     * @param index The index of the node.
+     * @return The node view.
+     * @throw std::out_of_range If the index is invalid or the node is not published yet.
+     */
+    Node getNode(size_t index) const { return Node(this, index, &readySlot(index)); }
+
+    inline Node getRoot() const { return getNode(0); }
+
+    /**
+     * @brief Converts the tree to a `lightweight::Tree` with the same indices, children being
+     * sorted by index. Writers must have finished.
+     *
+     * @return The converted tree.
+     * @throw std::logic_error If a reserved node is not published.
+     */
+    lightweight::Tree<T> toTree() const {
+        const size_t n = size();
+        lightweight::Tree<T> tree(slot(0).value(), n);
+        for (size_t i = 1; i < n; ++i) {
+            const Slot& s = slot(i);
+            if (!s.ready.load(std::memory_order_acquire)) {
+                throw std::logic_error("Cannot convert a concurrent tree while nodes are being added.");
+            }
+            tree.addChild(s.parent, s.value());
+        }
+        return tree;
+    }
+};
+
+template <typename T>
+constexpr size_t Tree<T>::NONE;
+
+} // namespace concurrent
+} // namespace vpr
+
+#endif // CONCURRENT_TREE_HPP
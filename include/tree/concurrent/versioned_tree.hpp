@@ -0,0 +1,118 @@
+#ifndef VERSIONED_TREE_HPP
+#define VERSIONED_TREE_HPP
+
+#include "versioned_graph.hpp"
+
+namespace vpr {
+namespace concurrent {
+
+/**
+ * @brief A tree with snapshot isolation: readers traverse a consistent version while a
+ * single writer keeps calling `addChild`.
+ *
+ * Children added by the writer become visible atomically at `publish()`. Readers call
+ * `snapshot()` from any thread and never take a lock, replacing the reader-writer lock
+ * otherwise needed around every traversal. Nodes never move; the child arrays the writer
+ * outgrows are reclaimed once the snapshots that may read them are released.
+ *
+ * As with the other trees, the root is node 0, a child always has a larger index than its
+ * parent and children are listed in index order.
+ *
+ * @tparam T The type of the value stored in each node.
+ */
+template <typename T>
+class VersionedTree : public detail::VersionedStore<T> {
+    using Base = detail::VersionedStore<T>;
+
+    templates::SegmentedVector<size_t> parents_; ///< Parent of every node, 0 for the root.
+    templates::SegmentedVector<size_t> depths_;  ///< Depth of every node.
+
+public:
+
+    /**
+     * @brief Read-only view of a node as of a snapshot.
+     */
+    class Node {
+
+        const VersionedTree* tree_; ///< Owning tree.
+        size_t index_;              ///< Index of the node.
+        size_t edges_;              ///< Edge count of the snapshot.
+
+    public:
+        using DataType = T;
+
+        Node(const VersionedTree* tree, size_t index, size_t edges) : tree_(tree), index_(index), edges_(edges) {}
+
+        size_t index() const noexcept { return index_; }
+        size_t parentId() const { return tree_->parents_[index_]; }
+        size_t depth() const { return tree_->depths_[index_]; }
+        bool isRoot() const noexcept { return index_ == 0; }
+        const T& value() const { return tree_->valueAt(index_); }
+        const T& operator*() const { return value(); }
+        const T* operator->() const { return &value(); }
+
+        /**
+         * @brief Returns the children of the node in this version, in index order.
+         */
+        detail::EdgeRange children() const { return tree_->edgesAt(index_, edges_); }
+        size_t nChildren() const { return children().size(); }
+        bool isLeaf() const { return children().empty(); }
+    };
+
+    /**
+     * @brief A consistent version of the tree, see `detail::Snapshot`.
+     */
+    class Snapshot : public detail::Snapshot<VersionedTree, Node> {
+    public:
+        using StoreType = VersionedTree;
+        using detail::Snapshot<VersionedTree, Node>::Snapshot;
+
+        Node getRoot() const { return this->getNode(0); }
+    };
+
+    /**
+     * @brief Constructs a tree with a root value, published immediately.
+     *
+     * @param root The value of the root node.
+     * @param initialCapacity Number of nodes for which storage is allocated up front.
+     * @param maxReaders Maximum number of snapshots alive at once, 0 for a default.
+     */
+    explicit VersionedTree(T root, size_t initialCapacity = 64, size_t maxReaders = 0)
+        : Base(initialCapacity, maxReaders) {
+        parents_.reserve(initialCapacity);
+        depths_.reserve(initialCapacity);
+        Base::appendNode(std::move(root));
+        parents_.push_back(0);
+        depths_.push_back(0);
+        Base::publish();
+    }
+
+    /**
+     * @brief Adds a child to a node. Writer only; visible after `publish()`.
+     *
+     * @param parent_index The index of the parent, published or not.
+     * @param value The value of the child.
+     * @return The index of the new child.
+     * @throw std::out_of_range If the parent index is invalid.
+     */
+    size_t addChild(size_t parent_index, T value) {
+        Base::validateIndex(parent_index);
+        const size_t index = Base::appendNode(std::move(value));
+        parents_.push_back(parent_index);
+        depths_.push_back(depths_[parent_index] + 1);
+        Base::appendEdge(parent_index, index);
+        return index;
+    }
+
+    /**
+     * @brief Takes a snapshot of the last published version. Safe from any thread.
+     *
+     * @throw std::length_error If `maxReaders` snapshots are already alive.
+     */
+    Snapshot snapshot() const { return Base::template takeSnapshot<Snapshot>(this); }
+};
+
+} // namespace concurrent
+} // namespace vpr
+
+#endif // VERSIONED_TREE_HPP
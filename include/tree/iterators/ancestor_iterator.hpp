@@ -0,0 +1,85 @@
+#ifndef ANCESTOR_ITERATOR_HPP
+#define ANCESTOR_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+namespace vpr {
+
+/**
+ * @class AncestorIterator
+ * @brief Forward iterator climbing from a node to the root through `parentId()`.
+ *
+ * The iterator only holds the tree and the current index, so iterating allocates nothing.
+ *
+ * @tparam NodeType The type of the nodes in the tree.
+ * @tparam TreeType The type of the tree being traversed.
+ */
+template <typename NodeType, typename TreeType>
+class AncestorIterator {
+
+    TreeType* tree_;      ///< Pointer to the tree being traversed.
+    size_t currentIndex_; ///< Index of the current node, `static_cast<size_t>(-1)` at the end.
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodeType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = NodeType*;
+    using reference = NodeType&;
+
+    /**
+     * @brief Constructs an iterator positioned on a node.
+     *
+     * @param tree Pointer to the tree.
+     * @param index The index of the current node, `static_cast<size_t>(-1)` for the end.
+     */
+    AncestorIterator(TreeType* tree, size_t index) : tree_(tree), currentIndex_(index) {}
+
+    reference operator*() const { return tree_->getNode(currentIndex_); }
+    pointer operator->() const { return &tree_->getNode(currentIndex_); }
+
+    /**
+     * @brief Moves to the parent of the current node, or to the end after the root.
+     */
+    AncestorIterator& operator++() {
+        currentIndex_ = currentIndex_ == 0 ? static_cast<size_t>(-1) : tree_->getNode(currentIndex_).parentId();
+        return *this;
+    }
+
+    AncestorIterator operator++(int) {
+        AncestorIterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    bool operator==(const AncestorIterator& other) const { return currentIndex_ == other.currentIndex_; }
+    bool operator!=(const AncestorIterator& other) const { return currentIndex_ != other.currentIndex_; }
+};
+
+/**
+ * @class AncestorRange
+ * @brief Range over the ancestors of a node, from its parent up to the root.
+ *
+ * @tparam NodeType The type of the nodes in the tree.
+ * @tparam TreeType The type of the tree being traversed.
+ */
+template <typename NodeType, typename TreeType>
+class AncestorRange {
+
+    TreeType* tree_; ///< Pointer to the tree being traversed.
+    size_t first_;   ///< Index of the first ancestor, `static_cast<size_t>(-1)` if there is none.
+
+public:
+    using iterator = AncestorIterator<NodeType, TreeType>;
+
+    AncestorRange(TreeType* tree, size_t first) : tree_(tree), first_(first) {}
+
+    iterator begin() const { return iterator(tree_, first_); }
+    iterator end() const { return iterator(tree_, static_cast<size_t>(-1)); }
+    bool empty() const { return first_ == static_cast<size_t>(-1); }
+};
+
+} // namespace vpr
+
+#endif // ANCESTOR_ITERATOR_HPP
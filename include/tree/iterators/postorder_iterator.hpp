@@ -57,11 +57,9 @@ public:
         this->nodeStack_.pop();
 
         if (!this->nodeStack_.empty()) {
-            size_t parentIndex = this->nodeStack_.top();
-            const auto& siblings = this->tree_->getNode(parentIndex).edges();
-            auto it = std::find(siblings.begin(), siblings.end(), this->currentIndex_);
-            if (it != siblings.end() && ++it != siblings.end()) {
-                traverseToLeftmostLeaf(*it);
+            size_t sibling = this->tree_->nextSibling(this->currentIndex_);
+            if (sibling != static_cast<size_t>(-1)) {
+                traverseToLeftmostLeaf(sibling);
             }
         }
     }
@@ -2,6 +2,7 @@
 #define TREE_HPP
 
 #include "lightweight_tree_node.hpp"
+#include "segmented_vector.hpp"
 #include "tree_template.hpp"
 
 namespace vpr {
@@ -10,6 +11,13 @@ namespace lightweight {
 template <typename T>
 using Tree = templates::Tree<tree::Node<T>, std::vector>;
 
+/**
+ * @brief A tree storing its nodes in `templates::SegmentedVector` blocks, so that adding
+ * nodes never moves the existing ones and references to them stay valid.
+ */
+template <typename T>
+using StableTree = templates::Tree<tree::Node<T>, templates::SegmentedVector>;
+
 
 } // namespace lightweight
 } // namespace vpr
@@ -73,6 +73,30 @@ public:
      */
     inline size_t parentId() const { return parent_id_; }
 
+    /**
+     * @brief Renumbers the node, its children and its parent after compaction.
+     *
+     * A node whose parent was not kept becomes a root and points to itself.
+     *
+     * @tparam Remap Any table indexable by an old node index, e.g. `std::vector<size_t>`.
+     * @param remap Table mapping every old node index to its new index.
+     */
+    template <typename Remap>
+    void remap(const Remap& remap) {
+        Base::remap(remap);
+        size_t parent = remap[parent_id_];
+        parent_id_ = parent == static_cast<size_t>(-1) ? Base::index() : parent;
+    }
+
+    /**
+     * @brief Attaches the node to a new parent, when a subtree is moved to another position.
+     *
+     * The edge lists of the old and new parents are not modified.
+     *
+     * @param parent_id The index of the new parent node.
+     */
+    inline void reparent(size_t parent_id) { parent_id_ = parent_id; }
+
 };
 
 
@@ -34,7 +34,9 @@ public:
      */
     explicit Tree(T root, size_t initial_capacity = 16) {
         this->nodes_.reserve(initial_capacity);
-        Base::emplace_node(this, 0, std::move(root));
+        this->depths_.reserve(initial_capacity);
+        this->child_indices_.reserve(initial_capacity);
+        Base::emplace_root(this, 0, std::move(root));
     }
 
     /**
@@ -69,7 +71,7 @@ public:
      */
     Tree& operator=(const Tree& other) {
         if (this != &other) {
-            Base::nodes_ = other.nodes_;
+            Base::operator=(other);
             syncNodes();
         }
         return *this;
@@ -84,18 +86,51 @@ public:
      * @param parent_index The index of the parent node.
      * @param value The value of type `T` to be stored in the child node.
      * @return The index of the newly added child node.
+     * @throw std::out_of_range If the parent index is invalid.
+     * @throw std::invalid_argument If the parent is removed.
      */
     size_t addChild(size_t parent_index, T value) {
-        Base::validateIndex(parent_index);
-        size_t id = Base::emplace_node(this, parent_index, std::move(value));
-        Base::addEdge(parent_index, id);
-        return id;
+        return Base::emplace_child(parent_index, this, parent_index, std::move(value));
+    }
+
+    /**
+     * @brief Moves the subtree rooted at a node out of this tree into a new, compact tree.
+     *
+     * See `templates::Tree::extractSubtree()`. The moved nodes are attached to the new tree.
+     *
+     * @param index The index of the subtree root.
+     * @return A tree holding the subtree.
+     */
+    Tree extractSubtree(size_t index) {
+        Tree result;
+        Base::extractInto(result, index);
+        result.syncNodes();
+        return result;
+    }
+
+    /**
+     * @brief Appends another tree below a node.
+     *
+     * See `templates::Tree::graft()`. The appended nodes are attached to this tree.
+     *
+     * @param parent_index The index of the node receiving the tree.
+     * @param other The tree to append, moved or copied in.
+     * @return The index of the former root of `other` in this tree.
+     */
+    size_t graft(size_t parent_index, Tree other) {
+        size_t root = Base::graft(parent_index, std::move(other));
+        for (size_t i = root; i < Base::size(); ++i) {
+            this->nodes_[i].tree_ = this;
+        }
+        return root;
     }
 
     inline Node& getRoot() { return Base::getNode(0); }
 
 private:
 
+    Tree() = default;
+
     /**
      * @brief Synchronizes the nodes to ensure they reference the correct tree.
      * 
@@ -57,6 +57,27 @@ public:
         return tree_->addChild(Base::index(), std::move(data));
     }
 
+    /**
+     * @brief Returns the position of this node among the children of its parent in O(1).
+     *
+     * @return The child index of the node, 0 for the root.
+     */
+    size_t childIndex() const { return tree_->childIndex(Base::index()); }
+
+    /**
+     * @brief Returns the index of the next sibling of this node in O(1).
+     *
+     * @return The index of the sibling, or `static_cast<size_t>(-1)` if there is none.
+     */
+    size_t nextSibling() const { return tree_->nextSibling(Base::index()); }
+
+    /**
+     * @brief Returns the index of the previous sibling of this node in O(1).
+     *
+     * @return The index of the sibling, or `static_cast<size_t>(-1)` if there is none.
+     */
+    size_t prevSibling() const { return tree_->prevSibling(Base::index()); }
+
     /**
      * @brief Retrieves the children of this node.
      * 
@@ -6,6 +6,17 @@
 #include "postorder_iterator.hpp"
 #include "preorder_iterator.hpp"
 #include "bfs_iterator.hpp"
+#include "ancestor_iterator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace vpr {
 namespace templates {
@@ -46,10 +57,140 @@ private:
     using ReversePreOrderTraversalType = ReversePreOrderTraversal<Tree>;
     using ConstReversePreOrderTraversalType = ReversePreOrderTraversal<const Tree>;
 
+    // Iterator types returned by the traversal methods
+    template <typename Traversal>
+    using Iterator = TreeIterator<Node, Tree, Traversal>;
+    template <typename Traversal>
+    using ConstIterator = TreeIterator<const Node, const Tree, Traversal>;
+
+    /**
+     * @brief Remap table for a few nodes, every other index mapping to `static_cast<size_t>(-1)`.
+     */
+    struct SparseRemap {
+        std::unordered_map<size_t, size_t> table;
+
+        size_t operator[](size_t index) const {
+            auto it = table.find(index);
+            return it == table.end() ? static_cast<size_t>(-1) : it->second;
+        }
+    };
+
+    /**
+     * @brief Remap table shifting every index by a constant offset.
+     */
+    struct OffsetRemap {
+        size_t offset;
+
+        size_t operator[](size_t index) const { return index + offset; }
+    };
+
 protected:
 
+    std::vector<size_t> depths_;        ///< Depth of every node, the root having depth 0.
+    std::vector<size_t> child_indices_; ///< Position of every node in the edges of its parent.
+
     Tree() = default;
 
+    /**
+     * @brief Constructs the root node in place.
+     *
+     * @tparam Args Types of the arguments forwarded to the node constructor after its index.
+     * @param args Arguments used to construct the root node.
+     */
+    template <typename... Args>
+    void emplace_root(Args&&... args) {
+        Base::emplace_node(std::forward<Args>(args)...);
+        depths_.assign(1, 0);
+        child_indices_.assign(1, 0);
+    }
+
+    /**
+     * @brief Constructs a child node in place and links it to its parent.
+     *
+     * Keeps the depth and child index columns up to date: a child is one level deeper than
+     * its parent and, having the largest index so far, is always its last child.
+     *
+     * @tparam Args Types of the arguments forwarded to the node constructor after its index.
+     * @param parent_index The index of the parent node.
+     * @param args Arguments used to construct the child node.
+     * @return The index of the newly created child node.
+     * @throw std::out_of_range If the parent index is invalid.
+     * @throw std::invalid_argument If the parent is removed.
+     */
+    template <typename... Args>
+    size_t emplace_child(size_t parent_index, Args&&... args) {
+        Base::validateIndex(parent_index);
+        if (Base::isRemoved(parent_index)) {
+            throw std::invalid_argument("Cannot add a child to a removed node.");
+        }
+        size_t id = Base::emplace_node(std::forward<Args>(args)...);
+        Base::addEdge(parent_index, id);
+        depths_.push_back(depths_[parent_index] + 1);
+        child_indices_.push_back(this->nodes_[parent_index].degree() - 1);
+        return id;
+    }
+
+    /**
+     * @brief Removes a node from the edges of its parent and renumbers its next siblings.
+     *
+     * Runs in O(degree of the parent).
+     */
+    void detachFromParent(size_t index) {
+        Node& parent = this->nodes_[this->nodes_[index].parentId()];
+        parent.removeEdge(index);
+        const auto& siblings = parent.edges();
+        for (size_t i = child_indices_[index]; i < siblings.size(); ++i) {
+            child_indices_[siblings[i]] = i;
+        }
+    }
+
+    /**
+     * @brief Moves the subtree rooted at `index` into `target`, which is cleared first.
+     *
+     * See `extractSubtree()`.
+     */
+    void extractInto(Tree& target, size_t index) {
+        Base::validateIndex(index);
+        if (index == 0) {
+            throw std::invalid_argument("Cannot extract the root node.");
+        }
+        if (Base::isRemoved(index)) {
+            throw std::invalid_argument("Cannot extract a removed node.");
+        }
+
+        // Pre-order numbering keeps parents before children and, children being numbered in
+        // edge order, keeps sorted edge containers sorted.
+        SparseRemap remap;
+        std::vector<size_t> order;
+        std::vector<size_t> pending(1, index);
+        while (!pending.empty()) {
+            size_t current = pending.back();
+            pending.pop_back();
+            remap.table.emplace(current, order.size());
+            order.push_back(current);
+            const auto& children = this->nodes_[current].edges();
+            pending.insert(pending.end(), children.rbegin(), children.rend());
+        }
+
+        target.clear();
+        target.adjacency_mode_ = this->adjacency_mode_;
+        target.sorted_ = this->sorted_;
+        target.nodes_.reserve(order.size());
+        target.depths_.reserve(order.size());
+        target.child_indices_.reserve(order.size());
+
+        detachFromParent(index);
+        const size_t baseDepth = depths_[index];
+        for (size_t old : order) {
+            target.nodes_.emplace_back(std::move(this->nodes_[old]));
+            target.nodes_.back().remap(remap);
+            target.depths_.push_back(depths_[old] - baseDepth);
+            target.child_indices_.push_back(child_indices_[old]);
+            Base::markRemoved(old);
+        }
+        target.child_indices_[0] = 0;
+    }
+
 public:
 
     /**
@@ -63,7 +204,9 @@ public:
      * @param initial_capacity The initial capacity for the tree's container. Defaults to 16.
      */
     explicit Tree(T root, size_t initial_capacity = 16) : Base(initial_capacity) {
-        Base::emplace_node(0, std::move(root));
+        depths_.reserve(initial_capacity);
+        child_indices_.reserve(initial_capacity);
+        emplace_root(0, std::move(root));
     }
 
     /**
@@ -75,45 +218,573 @@ public:
      * @param parent_index The index of the parent node.
      * @param value The value to be stored in the child node.
      * @return The index of the newly created child node.
+     * @throw std::out_of_range If the parent index is invalid.
+     * @throw std::invalid_argument If the parent is removed.
      */
     size_t addChild(size_t parent_index, T value) {
-        Base::validateIndex(parent_index);
-        size_t id = Base::emplace_node(parent_index, std::move(value));
-        Base::addEdge(parent_index, id);
-        return id;
+        return emplace_child(parent_index, parent_index, std::move(value));
+    }
+
+    /**
+     * @brief Returns the depth of a node in O(1).
+     *
+     * The root has depth 0 and every child is one level deeper than its parent.
+     *
+     * @param index The index of the node.
+     * @return The depth of the node.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t depth(size_t index) const {
+        Base::validateIndex(index);
+        return depths_[index];
+    }
+
+    /**
+     * @brief Removes every node, including the root.
+     */
+    void clear() noexcept {
+        Base::clear();
+        depths_.clear();
+        child_indices_.clear();
+    }
+
+    /**
+     * @brief Releases the unused capacity of the nodes, their edges and the depth and child index columns.
+     */
+    void shrink_to_fit() {
+        Base::shrink_to_fit();
+        depths_.shrink_to_fit();
+        child_indices_.shrink_to_fit();
+    }
+
+    /**
+     * @brief Returns the memory held by the tree, without the heap owned by the node values.
+     */
+    MemoryUsage memoryUsage() const {
+        return memoryUsage([](const T&) { return size_t(0); });
+    }
+
+    /**
+     * @brief Returns the memory held by the tree, see `Graph::memoryUsage(valueHeap)`.
+     *
+     * The depth and child index columns are counted as auxiliary bytes.
+     */
+    template <typename ValueHeapFn>
+    MemoryUsage memoryUsage(ValueHeapFn valueHeap) const {
+        MemoryUsage usage = Base::memoryUsage(valueHeap);
+        usage.auxiliaryBytes += (depths_.capacity() + child_indices_.capacity()) * sizeof(size_t);
+        return usage;
     }
 
+    /**
+     * @brief Returns the position of a node among the children of its parent in O(1).
+     *
+     * @param index The index of the node.
+     * @return The position of the node in the edges of its parent, 0 for the root.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t childIndex(size_t index) const {
+        Base::validateIndex(index);
+        return child_indices_[index];
+    }
+
+    /**
+     * @brief Returns the next sibling of a node in O(1).
+     *
+     * @param index The index of the node.
+     * @return The index of the next child of the same parent, or
+     *         `static_cast<size_t>(-1)` for a last child, the root or a removed node.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t nextSibling(size_t index) const {
+        Base::validateIndex(index);
+        if (index == 0 || Base::isRemoved(index)) {
+            return static_cast<size_t>(-1);
+        }
+        const auto& siblings = this->nodes_[this->nodes_[index].parentId()].edges();
+        const size_t next = child_indices_[index] + 1;
+        return next < siblings.size() ? siblings[next] : static_cast<size_t>(-1);
+    }
+
+    /**
+     * @brief Returns the previous sibling of a node in O(1).
+     *
+     * @param index The index of the node.
+     * @return The index of the previous child of the same parent, or
+     *         `static_cast<size_t>(-1)` for a first child, the root or a removed node.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    size_t prevSibling(size_t index) const {
+        Base::validateIndex(index);
+        if (index == 0 || Base::isRemoved(index) || child_indices_[index] == 0) {
+            return static_cast<size_t>(-1);
+        }
+        return this->nodes_[this->nodes_[index].parentId()].edges()[child_indices_[index] - 1];
+    }
+
+    /**
+     * @brief Returns the ancestors of a node, from its parent up to the root.
+     *
+     * The range walks `parentId()` lazily and allocates nothing.
+     *
+     * @param index The index of the node.
+     * @return A forward range of nodes, empty for the root.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    AncestorRange<Node, Tree> ancestors(size_t index) {
+        Base::validateIndex(index);
+        return AncestorRange<Node, Tree>(this, index == 0 ? static_cast<size_t>(-1) : this->nodes_[index].parentId());
+    }
+
+    /**
+     * @brief Returns the ancestors of a node, from its parent up to the root (const version).
+     *
+     * @param index The index of the node.
+     * @return A forward range of nodes, empty for the root.
+     * @throw std::out_of_range If the index is invalid.
+     */
+    AncestorRange<const Node, const Tree> ancestors(size_t index) const {
+        Base::validateIndex(index);
+        return AncestorRange<const Node, const Tree>(this, index == 0 ? static_cast<size_t>(-1) : this->nodes_[index].parentId());
+    }
+
+    /**
+     * @brief Drops the removed nodes and renumbers the live ones into dense storage.
+     *
+     * See `Graph::compact()`. Parent indices and the depth and child index columns are
+     * remapped as well; children keep their relative order, so their positions do not change.
+     *
+     * @return A table mapping every old index to its new index, or to
+     *         `static_cast<size_t>(-1)` for removed nodes.
+     */
+    std::vector<size_t> compact() {
+        std::vector<size_t> remap = Base::compact();
+        size_t next = 0;
+        for (size_t i = 0; i < remap.size(); ++i) {
+            if (remap[i] != static_cast<size_t>(-1)) {
+                depths_[next] = depths_[i];
+                child_indices_[next] = child_indices_[i];
+                ++next;
+            }
+        }
+        depths_.resize(next);
+        child_indices_.resize(next);
+        return remap;
+    }
+
+    /**
+     * @brief Removes a node together with all its descendants.
+     *
+     * The node is detached from its parent and every node of the subtree becomes a tombstone,
+     * so traversals no longer reach them. Their slots are reclaimed by `compact()`.
+     * Runs in O(subtree size + degree of the parent).
+     *
+     * @param index The index of the subtree root.
+     * @return The number of nodes removed.
+     * @throw std::out_of_range If the index is invalid.
+     * @throw std::invalid_argument If the index refers to the root of the tree.
+     */
+    size_t removeSubtree(size_t index) {
+        Base::validateIndex(index);
+        if (index == 0) {
+            throw std::invalid_argument("Cannot remove the root node.");
+        }
+        if (Base::isRemoved(index)) {
+            return 0;
+        }
+
+        detachFromParent(index);
+
+        size_t removed = 0;
+        std::vector<size_t> pending(1, index);
+        while (!pending.empty()) {
+            size_t current = pending.back();
+            pending.pop_back();
+            const auto& children = this->nodes_[current].edges();
+            pending.insert(pending.end(), children.begin(), children.end());
+            Base::markRemoved(current);
+            ++removed;
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Moves the subtree rooted at a node out of this tree into a new, compact tree.
+     *
+     * The node becomes the root of the returned tree and its descendants are numbered in
+     * pre-order. Values are moved, not copied, and the extracted nodes are left as tombstones
+     * in this tree until `compact()` is called. Runs in O(subtree size + degree of the parent).
+     *
+     * @param index The index of the subtree root.
+     * @return A tree holding the subtree.
+     * @throw std::out_of_range If the index is invalid.
+     * @throw std::invalid_argument If the index refers to the root or to a removed node.
+     */
+    Tree extractSubtree(size_t index) {
+        Tree result;
+        extractInto(result, index);
+        return result;
+    }
+
+    /**
+     * @brief Makes a node the new root and frees every node outside its subtree, in place.
+     *
+     * The kept nodes keep their relative order, so the new root gets index 0, nodes stay
+     * stored after their parent and depths are shifted by the depth of the new root. All the
+     * indices are rewritten in a single remap pass over the storage, as by `compact()`.
+     *
+     * @param index The index of the new root.
+     * @return A table mapping every old index to its new index, or to
+     *         `static_cast<size_t>(-1)` for the freed nodes.
+     * @throw std::out_of_range If the index is invalid.
+     * @throw std::invalid_argument If the index refers to a removed node.
+     */
+    std::vector<size_t> keepOnlySubtree(size_t index) {
+        Base::validateIndex(index);
+        if (Base::isRemoved(index)) {
+            throw std::invalid_argument("Cannot keep a removed node.");
+        }
+
+        const size_t n = this->nodes_.size();
+        this->removed_.assign(n, 1);
+        this->removed_count_ = n;
+        std::vector<size_t> pending(1, index);
+        while (!pending.empty()) {
+            size_t current = pending.back();
+            pending.pop_back();
+            this->removed_[current] = 0;
+            --this->removed_count_;
+            const auto& children = this->nodes_[current].edges();
+            pending.insert(pending.end(), children.begin(), children.end());
+        }
+
+        const size_t baseDepth = depths_[index];
+        std::vector<size_t> remap = compact();
+        for (size_t& depth : depths_) {
+            depth -= baseDepth;
+        }
+        child_indices_[0] = 0;
+        return remap;
+    }
+
+    /**
+     * @brief Appends another tree below a node.
+     *
+     * The nodes of `other` are moved to the end of the storage in their current order, with
+     * every index shifted by the same offset, and its root becomes the last child of `parent`.
+     * Removed nodes of `other` are compacted away first. Runs in O(size of `other`).
+     *
+     * @param parent_index The index of the node receiving the tree.
+     * @param other The tree to append, moved or copied in.
+     * @return The index of the former root of `other` in this tree.
+     * @throw std::out_of_range If the parent index is invalid.
+     * @throw std::invalid_argument If the parent is removed or `other` is empty.
+     */
+    size_t graft(size_t parent_index, Tree other) {
+        Base::validateIndex(parent_index);
+        if (Base::isRemoved(parent_index)) {
+            throw std::invalid_argument("Cannot graft below a removed node.");
+        }
+        if (other.empty()) {
+            throw std::invalid_argument("Cannot graft an empty tree.");
+        }
+        other.compact();
+
+        const OffsetRemap remap{this->nodes_.size()};
+        const size_t parentDepth = depths_[parent_index];
+        this->nodes_.reserve(this->nodes_.size() + other.nodes_.size());
+        depths_.reserve(depths_.size() + other.depths_.size());
+        child_indices_.reserve(child_indices_.size() + other.child_indices_.size());
+        for (size_t i = 0; i < other.nodes_.size(); ++i) {
+            this->nodes_.emplace_back(std::move(other.nodes_[i]));
+            this->nodes_.back().remap(remap);
+            depths_.push_back(other.depths_[i] + parentDepth + 1);
+            child_indices_.push_back(other.child_indices_[i]);
+            if (!this->removed_.empty()) {
+                this->removed_.push_back(0);
+            }
+        }
+
+        Node& root = this->nodes_[remap.offset];
+        root.reparent(parent_index);
+        if (!other.sorted_) {
+            if (this->adjacency_mode_ == AdjacencyMode::SortedUnique) {
+                for (size_t i = remap.offset; i < this->nodes_.size(); ++i) {
+                    this->nodes_[i].normalizeEdges();
+                }
+            } else {
+                this->sorted_ = false;
+            }
+        }
+        Base::addEdge(parent_index, remap.offset);
+        child_indices_[remap.offset] = this->nodes_[parent_index].degree() - 1;
+        return remap.offset;
+    }
 
     inline const Node& getRoot() const { return Base::getNode(0); }
 
+    /**
+     * @brief Computes a value for every subtree, bottom-up.
+     *
+     * The value of a node is `leaf_fn(node)` folded with the values of its children, in
+     * child order, through `combine_fn(accumulated, child_value)`. For example subtree sizes
+     * are obtained with `leaf_fn = [](const Node&) { return size_t(1); }` and
+     * `combine_fn = [](size_t& acc, size_t child) { acc += child; }`.
+     *
+     * Nodes are grouped by depth and the levels are processed from the deepest one up, each
+     * level being split among a team of work-stealing workers. Trees whose levels are too
+     * narrow to be worth splitting (fewer than `grain` nodes per level on average) are reduced
+     * with a single reverse sweep over the node storage instead. No traversal iterator is used.
+     *
+     * If `leaf_fn` or `combine_fn` throws, the remaining nodes are skipped and the first
+     * exception is rethrown once every worker has stopped.
+     *
+     * @tparam LeafFn Callable `R(const Node&)`.
+     * @tparam CombineFn Callable `void(R&, const R&)`.
+     * @param leaf_fn Computes the initial value of a node.
+     * @param combine_fn Folds the value of a child into the value of its parent.
+     * @param nThreads Number of threads to use, including the calling thread.
+     * @param grain Number of nodes handed to a worker at a time.
+     * @return One value per node index; removed nodes get a value-initialized `R`.
+     */
+    template <typename LeafFn, typename CombineFn>
+    std::vector<typename std::decay<decltype(std::declval<LeafFn&>()(std::declval<const Node&>()))>::type>
+    reduce_subtrees(LeafFn leaf_fn, CombineFn combine_fn,
+                    size_t nThreads = parallel::hardwareConcurrency(), size_t grain = 1024) const {
+        using R = typename std::decay<decltype(leaf_fn(std::declval<const Node&>()))>::type;
+        static_assert(!std::is_same<R, bool>::value,
+                      "std::vector<bool> cannot be written concurrently, reduce to char instead.");
+
+        const size_t n = this->nodes_.size();
+        std::vector<R> result(n);
+        auto reduceNode = [&](size_t index) {
+            const Node& node = this->nodes_[index];
+            R value = leaf_fn(node);
+            for (size_t child : node.edges()) {
+                combine_fn(value, result[child]);
+            }
+            result[index] = std::move(value);
+        };
+
+        size_t maxDepth = 0;
+        for (size_t index = 0; index < n; ++index) {
+            maxDepth = std::max(maxDepth, depths_[index]);
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+        if (nThreads <= 1 || n / (maxDepth + 1) < grain) {
+            // Children are always stored after their parent.
+            for (size_t index = n; index-- > 0;) {
+                if (!Base::isRemoved(index)) {
+                    reduceNode(index);
+                }
+            }
+            return result;
+        }
+
+        // Counting sort of the live nodes by depth.
+        std::vector<size_t> levelBegin(maxDepth + 2, 0);
+        for (size_t index = 0; index < n; ++index) {
+            if (!Base::isRemoved(index)) {
+                ++levelBegin[depths_[index] + 1];
+            }
+        }
+        for (size_t depth = 1; depth < levelBegin.size(); ++depth) {
+            levelBegin[depth] += levelBegin[depth - 1];
+        }
+        std::vector<size_t> byLevel(levelBegin.back());
+        std::vector<size_t> cursor(levelBegin.begin(), levelBegin.end() - 1);
+        for (size_t index = 0; index < n; ++index) {
+            if (!Base::isRemoved(index)) {
+                byLevel[cursor[depths_[index]]++] = index;
+            }
+        }
+
+        parallel::ChunkScheduler scheduler(nThreads);
+        parallel::SpinBarrier barrier(nThreads);
+        size_t level = maxDepth;
+        scheduler.reset((levelBegin[level + 1] - levelBegin[level] + grain - 1) / grain);
+
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        parallel::runTeam(nThreads, [&](size_t worker) {
+            while (true) {
+                const size_t begin = levelBegin[level];
+                const size_t end = levelBegin[level + 1];
+                size_t chunk;
+                while (!failed.load(std::memory_order_relaxed) && scheduler.next(worker, chunk)) {
+                    try {
+                        const size_t last = std::min(end, begin + (chunk + 1) * grain);
+                        for (size_t i = begin + chunk * grain; i < last; ++i) {
+                            reduceNode(byLevel[i]);
+                        }
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(errorMutex);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                // Every worker takes both barriers so the team always exits together;
+                // `failed` cannot change between them.
+                barrier.wait();
+                if (worker == 0 && level > 0) {
+                    --level;
+                    scheduler.reset((levelBegin[level + 1] - levelBegin[level] + grain - 1) / grain);
+                }
+                const bool done = begin == 0 || failed.load(std::memory_order_relaxed);
+                barrier.wait();
+                if (done) {
+                    break;
+                }
+            }
+        });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls `fn(node)` for every live node on the workers of an executor, every node
+     * being processed after its parent.
+     *
+     * The tree is cut into independent subtrees of at most `grain` nodes. The nodes above
+     * them, whose subtrees are larger, are processed first on the calling thread in index
+     * order. The subtrees are then grouped into tasks of about `grain` nodes, and each task
+     * is walked in pre-order by a single worker. This suits top-down work where a node reads
+     * the result of its parent, e.g. accumulating values from the root.
+     *
+     * `fn` may update the node it receives and read its ancestors, but must not add or
+     * remove nodes. If `fn` throws, the remaining tasks are skipped and the first exception is
+     * rethrown once every worker has stopped.
+     *
+     * @tparam Executor An executor such as `parallel::ThreadPool`.
+     * @tparam Fn Callable `void(Node&)`.
+     * @param executor The executor running the workers.
+     * @param fn Function applied to every live node.
+     * @param grain Maximum number of nodes of a subtree handed to a single worker.
+     */
+    template <typename Executor, typename Fn,
+              typename = typename std::enable_if<parallel::IsExecutor<Executor>::value>::type>
+    void parallel_for_each_subtree(Executor& executor, Fn fn, size_t grain = 1024) {
+        forEachSubtree(*this, executor, fn, grain);
+    }
+
+    template <typename Executor, typename Fn,
+              typename = typename std::enable_if<parallel::IsExecutor<Executor>::value>::type>
+    void parallel_for_each_subtree(Executor& executor, Fn fn, size_t grain = 1024) const {
+        forEachSubtree(*this, executor, fn, grain);
+    }
+
+    /**
+     * @brief Calls `fn(node)` for every live node on `parallel::defaultPool()`, every node
+     * being processed after its parent.
+     *
+     * @tparam Fn Callable `void(Node&)`.
+     * @param fn Function applied to every live node.
+     * @param grain Maximum number of nodes of a subtree handed to a single worker.
+     */
+    template <typename Fn>
+    void parallel_for_each_subtree(Fn fn, size_t grain = 1024) {
+        forEachSubtree(*this, parallel::defaultPool(), fn, grain);
+    }
+
+    template <typename Fn>
+    void parallel_for_each_subtree(Fn fn, size_t grain = 1024) const {
+        forEachSubtree(*this, parallel::defaultPool(), fn, grain);
+    }
+
     // *** Traversal Iterator Methods ***
-    inline auto pre_order_begin() { return TraversalIterator<PreOrderTraversalType, false>(); }
-    inline auto pre_order_end()   { return TraversalIterator<PreOrderTraversalType, true>(); }
-    inline auto pre_order_begin() const { return TraversalIterator<ConstPreOrderTraversalType, false>(); }
-    inline auto pre_order_end()   const { return TraversalIterator<ConstPreOrderTraversalType, true>(); }
-
-    inline auto post_order_begin() { return TraversalIterator<PostOrderTraversalType, false>(); }
-    inline auto post_order_end()   { return TraversalIterator<PostOrderTraversalType, true>(); }
-    inline auto post_order_begin() const { return TraversalIterator<ConstPostOrderTraversalType, false>(); }
-    inline auto post_order_end()   const { return TraversalIterator<ConstPostOrderTraversalType, true>(); }
-
-    inline auto bfs_begin() { return TraversalIterator<BFSTraversalType, false>(); }
-    inline auto bfs_end()   { return TraversalIterator<BFSTraversalType, true>(); }
-    inline auto bfs_begin() const { return TraversalIterator<ConstBFSTraversalType, false>(); }
-    inline auto bfs_end()   const { return TraversalIterator<ConstBFSTraversalType, true>(); }
-
-    inline auto bfs_rbegin() { return TraversalIterator<ReverseBFSTraversalType, false>(); }
-    inline auto bfs_rend()   { return TraversalIterator<ReverseBFSTraversalType, true>(); }
-    inline auto bfs_rbegin() const { return TraversalIterator<ConstReverseBFSTraversalType, false>(); }
-    inline auto bfs_rend()   const { return TraversalIterator<ConstReverseBFSTraversalType, true>(); }
-
-    inline auto pre_order_rbegin() { return TraversalIterator<ReversePreOrderTraversalType, false>(); }
-    inline auto pre_order_rend()   { return TraversalIterator<ReversePreOrderTraversalType, true>(); }
-    inline auto pre_order_rbegin() const { return TraversalIterator<ConstReversePreOrderTraversalType, false>(); }
-    inline auto pre_order_rend()   const { return TraversalIterator<ConstReversePreOrderTraversalType, true>(); }
+    inline Iterator<PreOrderTraversalType> pre_order_begin() { return TraversalIterator<PreOrderTraversalType, false>(); }
+    inline Iterator<PreOrderTraversalType> pre_order_end()   { return TraversalIterator<PreOrderTraversalType, true>(); }
+    inline ConstIterator<ConstPreOrderTraversalType> pre_order_begin() const { return TraversalIterator<ConstPreOrderTraversalType, false>(); }
+    inline ConstIterator<ConstPreOrderTraversalType> pre_order_end()   const { return TraversalIterator<ConstPreOrderTraversalType, true>(); }
+
+    inline Iterator<PostOrderTraversalType> post_order_begin() { return TraversalIterator<PostOrderTraversalType, false>(); }
+    inline Iterator<PostOrderTraversalType> post_order_end()   { return TraversalIterator<PostOrderTraversalType, true>(); }
+    inline ConstIterator<ConstPostOrderTraversalType> post_order_begin() const { return TraversalIterator<ConstPostOrderTraversalType, false>(); }
+    inline ConstIterator<ConstPostOrderTraversalType> post_order_end()   const { return TraversalIterator<ConstPostOrderTraversalType, true>(); }
+
+    inline Iterator<BFSTraversalType> bfs_begin() { return TraversalIterator<BFSTraversalType, false>(); }
+    inline Iterator<BFSTraversalType> bfs_end()   { return TraversalIterator<BFSTraversalType, true>(); }
+    inline ConstIterator<ConstBFSTraversalType> bfs_begin() const { return TraversalIterator<ConstBFSTraversalType, false>(); }
+    inline ConstIterator<ConstBFSTraversalType> bfs_end()   const { return TraversalIterator<ConstBFSTraversalType, true>(); }
+
+    inline Iterator<ReverseBFSTraversalType> bfs_rbegin() { return TraversalIterator<ReverseBFSTraversalType, false>(); }
+    inline Iterator<ReverseBFSTraversalType> bfs_rend()   { return TraversalIterator<ReverseBFSTraversalType, true>(); }
+    inline ConstIterator<ConstReverseBFSTraversalType> bfs_rbegin() const { return TraversalIterator<ConstReverseBFSTraversalType, false>(); }
+    inline ConstIterator<ConstReverseBFSTraversalType> bfs_rend()   const { return TraversalIterator<ConstReverseBFSTraversalType, true>(); }
+
+    inline Iterator<ReversePreOrderTraversalType> pre_order_rbegin() { return TraversalIterator<ReversePreOrderTraversalType, false>(); }
+    inline Iterator<ReversePreOrderTraversalType> pre_order_rend()   { return TraversalIterator<ReversePreOrderTraversalType, true>(); }
+    inline ConstIterator<ConstReversePreOrderTraversalType> pre_order_rbegin() const { return TraversalIterator<ConstReversePreOrderTraversalType, false>(); }
+    inline ConstIterator<ConstReversePreOrderTraversalType> pre_order_rend()   const { return TraversalIterator<ConstReversePreOrderTraversalType, true>(); }
 
 private:
 
+    /**
+     * @brief Shared implementation of the const and non-const `parallel_for_each_subtree`.
+     */
+    template <typename Self, typename Executor, typename Fn>
+    static void forEachSubtree(Self& self, Executor& executor, Fn& fn, size_t grain) {
+        const size_t n = self.nodes_.size();
+        if (grain == 0) {
+            grain = 1;
+        }
+        // Children are always stored after their parent.
+        std::vector<size_t> sizes(n, 0);
+        for (size_t index = n; index-- > 0;) {
+            if (!self.isRemoved(index)) {
+                size_t size = 1;
+                for (size_t child : self.nodes_[index].edges()) {
+                    size += sizes[child];
+                }
+                sizes[index] = size;
+            }
+        }
+
+        std::vector<size_t> roots;
+        for (size_t index = 0; index < n; ++index) {
+            if (self.isRemoved(index)) {
+                continue;
+            }
+            if (sizes[index] > grain) {
+                fn(self.nodes_[index]);
+            } else if (index == 0 || sizes[self.nodes_[index].parentId()] > grain) {
+                roots.push_back(index);
+            }
+        }
+
+        std::vector<size_t> taskBegin(1, 0);
+        size_t pending = 0;
+        for (size_t k = 0; k < roots.size(); ++k) {
+            pending += sizes[roots[k]];
+            if (pending >= grain || k + 1 == roots.size()) {
+                taskBegin.push_back(k + 1);
+                pending = 0;
+            }
+        }
+        parallel::parallelFor(executor, taskBegin.size() - 1, [&](size_t task) {
+            std::vector<size_t> stack;
+            for (size_t k = taskBegin[task]; k < taskBegin[task + 1]; ++k) {
+                stack.push_back(roots[k]);
+                while (!stack.empty()) {
+                    auto& node = self.nodes_[stack.back()];
+                    stack.pop_back();
+                    fn(node);
+                    const auto& children = node.edges();
+                    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                        stack.push_back(*it);
+                    }
+                }
+            }
+        });
+    }
+
     /**
      * @brief Helper method to create traversal iterators.
      *
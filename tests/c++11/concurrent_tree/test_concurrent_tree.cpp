@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_tree.hpp"
+
+using namespace vpr;
+
+TEST(ConcurrentTreeTest, SingleThreadedBehavesLikeATree) {
+    concurrent::Tree<std::string> tree("root", 1);
+    size_t a = tree.addChild(0, "a");
+    size_t b = tree.addChild(0, "b");
+    size_t c = tree.addChild(a, "c");
+
+    EXPECT_EQ(tree.size(), 4u);
+    EXPECT_EQ(tree.getNode(c).parentId(), a);
+    EXPECT_EQ(tree.getNode(c).depth(), 2u);
+    EXPECT_EQ(*tree.getNode(b), "b");
+    EXPECT_EQ(tree.getRoot().nChildren(), 2u);
+    auto children = tree.getRoot().children();
+    EXPECT_EQ(std::vector<size_t>(children.begin(), children.end()), std::vector<size_t>({b, a}));
+    EXPECT_TRUE(tree.getNode(b).isLeaf());
+    EXPECT_THROW(tree.getNode(4), std::out_of_range);
+    EXPECT_THROW(tree.addChild(9, "x"), std::out_of_range);
+
+    auto converted = tree.toTree();
+    ASSERT_EQ(converted.size(), 4u);
+    const auto& rootEdges = converted.getRoot().edges();
+    EXPECT_EQ(std::vector<size_t>(rootEdges.begin(), rootEdges.end()), std::vector<size_t>({a, b}));
+    EXPECT_EQ(converted.getNode(c).value(), "c");
+    EXPECT_EQ(converted.depth(c), 2u);
+}
+
+TEST(ConcurrentTreeTest, ConcurrentWritersAndReader) {
+    const size_t nWriters = 6;
+    const size_t perWriter = 3000;
+    concurrent::Tree<size_t> tree(0);
+    std::atomic<bool> done(false);
+    std::atomic<size_t> seen(0);
+
+    std::thread reader([&]() {
+        // Traverse while the tree grows: every reachable node must be complete.
+        while (!done.load()) {
+            size_t count = 0;
+            std::vector<size_t> stack(1, 0);
+            while (!stack.empty()) {
+                auto node = tree.getNode(stack.back());
+                stack.pop_back();
+                ++count;
+                for (size_t child : node.children()) {
+                    EXPECT_EQ(tree.getNode(child).parentId(), node.index());
+                    stack.push_back(child);
+                }
+            }
+            seen.store(count);
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (size_t w = 0; w < nWriters; ++w) {
+        writers.emplace_back([&tree, w, perWriter]() {
+            std::mt19937 rng(static_cast<unsigned>(w));
+            std::vector<size_t> mine(1, 0);
+            for (size_t i = 0; i < perWriter; ++i) {
+                size_t parent = mine[rng() % mine.size()];
+                mine.push_back(tree.addChild(parent, w * perWriter + i));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    reader.join();
+
+    const size_t n = 1 + nWriters * perWriter;
+    ASSERT_EQ(tree.size(), n);
+    EXPECT_LE(seen.load(), n);
+
+    size_t totalChildren = 0;
+    std::vector<size_t> valueCount(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        auto node = tree.getNode(i);
+        totalChildren += node.nChildren();
+        if (i != 0) {
+            EXPECT_LT(node.parentId(), i);
+            EXPECT_EQ(node.depth(), tree.getNode(node.parentId()).depth() + 1);
+            ++valueCount[node.value()];
+        }
+    }
+    EXPECT_EQ(totalChildren, n - 1);
+    EXPECT_EQ(std::count(valueCount.begin(), valueCount.begin() + nWriters * perWriter, 1u),
+              static_cast<long>(nWriters * perWriter));
+
+    auto converted = tree.toTree();
+    ASSERT_EQ(converted.size(), n);
+    for (size_t i = 1; i < n; ++i) {
+        EXPECT_EQ(converted.getNode(i).parentId(), tree.getNode(i).parentId());
+        EXPECT_EQ(converted.depth(i), tree.getNode(i).depth());
+    }
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "versioned_graph.hpp"
+#include "versioned_tree.hpp"
+
+using namespace vpr;
+
+TEST(VersionedTreeTest, SnapshotsKeepTheirVersion) {
+    concurrent::VersionedTree<std::string> tree("root");
+    tree.addChild(0, "a");
+    auto empty = tree.snapshot();
+    EXPECT_EQ(empty.size(), 1u);
+    EXPECT_TRUE(empty.getRoot().isLeaf());
+
+    tree.publish();
+    auto first = tree.snapshot();
+    for (size_t i = 0; i < 100; ++i) {
+        tree.addChild(i % 2, "n" + std::to_string(i));
+    }
+    tree.publish();
+    auto second = tree.snapshot();
+
+    EXPECT_EQ(empty.size(), 1u);
+    EXPECT_TRUE(empty.getRoot().isLeaf());
+    EXPECT_THROW(empty.getNode(1), std::out_of_range);
+
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first.getRoot().nChildren(), 1u);
+    EXPECT_EQ(first.getNode(1).value(), "a");
+    EXPECT_TRUE(first.getNode(1).isLeaf());
+
+    ASSERT_EQ(second.size(), 102u);
+    EXPECT_EQ(second.getRoot().nChildren(), 51u);
+    EXPECT_EQ(second.getNode(1).nChildren(), 50u);
+    const auto children = second.getNode(1).children();
+    EXPECT_EQ(children[0], 3u);
+    EXPECT_EQ(second.getNode(101).parentId(), 1u);
+    EXPECT_EQ(second.getNode(101).depth(), 2u);
+    EXPECT_EQ(*second.getNode(101), "n99");
+    EXPECT_THROW(tree.addChild(102, "x"), std::out_of_range);
+}
+
+TEST(VersionedTreeTest, ReclaimsBlocksOnceSnapshotsAreReleased) {
+    concurrent::VersionedTree<int> tree(0);
+    auto old = tree.snapshot();
+    for (int i = 1; i <= 64; ++i) {
+        tree.addChild(0, i);
+    }
+    tree.publish();
+    // The root's children grew from 4 to 64 entries through 4 replaced blocks.
+    EXPECT_EQ(tree.pendingReclamation(), 4u);
+    EXPECT_TRUE(old.getRoot().isLeaf());
+
+    old.release();
+    tree.publish();
+    EXPECT_EQ(tree.pendingReclamation(), 0u);
+    EXPECT_EQ(tree.snapshot().getRoot().nChildren(), 64u);
+
+    concurrent::VersionedTree<int> small(0, 16, 2);
+    auto a = small.snapshot();
+    auto b = small.snapshot();
+    EXPECT_THROW(small.snapshot(), std::length_error);
+}
+
+TEST(VersionedTreeTest, ReadersSeeConsistentVersionsWhileWriterAppends) {
+    const size_t nNodes = 20000;
+    concurrent::VersionedTree<size_t> tree(0);
+    std::atomic<bool> done(false);
+    std::atomic<size_t> failures(0);
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto snapshot = tree.snapshot();
+                // Every node of the version is reachable from the root, exactly once.
+                size_t reached = 0;
+                std::vector<size_t> stack(1, 0);
+                while (!stack.empty()) {
+                    auto node = snapshot.getNode(stack.back());
+                    stack.pop_back();
+                    ++reached;
+                    if (node.value() != node.index()) {
+                        ++failures;
+                    }
+                    for (size_t child : node.children()) {
+                        if (child >= snapshot.size() || snapshot.getNode(child).parentId() != node.index()) {
+                            ++failures;
+                        }
+                        stack.push_back(child);
+                    }
+                }
+                if (reached != snapshot.size()) {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (size_t i = 1; i < nNodes; ++i) {
+        tree.addChild((i * 2654435761u) % i, i);
+        if (i % 64 == 0) {
+            tree.publish();
+        }
+    }
+    tree.publish();
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_EQ(tree.snapshot().size(), nNodes);
+    // Blocks retired while readers were pinned are freed by the next publication.
+    tree.publish();
+    EXPECT_EQ(tree.pendingReclamation(), 0u);
+}
+
+TEST(VersionedGraphTest, UndirectedEdgesArePublishedTogether) {
+    concurrent::VersionedGraph<int> graph;
+    const size_t n = 200;
+    for (size_t i = 0; i < n; ++i) {
+        graph.emplace_node(static_cast<int>(i));
+    }
+    graph.publish();
+    std::atomic<bool> done(false);
+    std::atomic<size_t> failures(0);
+
+    std::thread reader([&]() {
+        while (!done.load()) {
+            auto snapshot = graph.snapshot();
+            size_t entries = 0;
+            for (size_t u = 0; u < snapshot.size(); ++u) {
+                for (size_t v : snapshot.getNode(u).edges()) {
+                    ++entries;
+                    const auto back = snapshot.getNode(v).edges();
+                    if (std::find(back.begin(), back.end(), u) == back.end()) {
+                        ++failures;
+                    }
+                }
+            }
+            if (entries != snapshot.edgeCount()) {
+                ++failures;
+            }
+        }
+    });
+
+    for (size_t k = 0; k < 3000; ++k) {
+        graph.addEdge(k % n, (k * 7 + 1) % n);
+        graph.publish();
+    }
+    done.store(true);
+    reader.join();
+    EXPECT_EQ(failures.load(), 0u);
+
+    concurrent::VersionedDigraph<std::string> digraph;
+    digraph.emplace_node("a");
+    digraph.emplace_node("b");
+    digraph.addEdge(0, 1);
+    digraph.addEdge(0, 0);
+    EXPECT_THROW(digraph.addEdge(0, 2), std::out_of_range);
+    auto before = digraph.snapshot();
+    digraph.publish();
+    auto after = digraph.snapshot();
+    EXPECT_EQ(before.size(), 0u);
+    ASSERT_EQ(after.size(), 2u);
+    EXPECT_EQ(after.getNode(0).degree(), 2u);
+    EXPECT_TRUE(after.getNode(1).isolated());
+    EXPECT_EQ(after.getNode(1).value(), "b");
+}
+
+TEST(VersionedGraphTest, EdgesOfASnapshotTargetItsNodes) {
+    concurrent::VersionedDigraph<int> graph;
+    graph.emplace_node(0);
+    graph.publish();
+    std::atomic<bool> done(false);
+    std::atomic<size_t> failures(0);
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto snapshot = graph.snapshot();
+                // The newest edge always targets the newest node.
+                const auto edges = snapshot.getNode(0).edges();
+                if (!edges.empty() && edges[edges.size() - 1] >= snapshot.size()) {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i < 200000; ++i) {
+        const size_t v = graph.emplace_node(i);
+        graph.addEdge(0, v);
+        graph.publish();
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+    EXPECT_EQ(graph.snapshot().getNode(0).degree(), 199999u);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "bfs.hpp"
+#include "lightweight_graph.hpp"
+#include "lightweight_digraph.hpp"
+
+using namespace vpr;
+
+/**
+ * @brief Builds a graph with `n` nodes and `m` random edges, using a fixed seed.
+ */
+template <typename GraphType>
+GraphType randomGraph(size_t n, size_t m, unsigned seed) {
+    GraphType graph;
+    for (size_t i = 0; i < n; ++i) {
+        graph.emplace_node(static_cast<int>(i));
+    }
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (size_t i = 0; i < m; ++i) {
+        graph.addEdge(pick(rng), pick(rng));
+    }
+    return graph;
+}
+
+TEST(BfsTest, DistancesOnPath) {
+    lightweight::Digraph<int> graph;
+    for (int i = 0; i < 5; ++i) {
+        graph.emplace_node(i);
+    }
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 3);
+    graph.addEdge(0, 2);
+
+    std::vector<size_t> expected = {0, 1, 1, 2, algorithms::UNREACHABLE};
+    EXPECT_EQ(algorithms::bfsDistances(graph, 0), expected);
+    EXPECT_EQ(algorithms::parallelBfsDistances(graph, 0, 4, 1), expected);
+}
+
+TEST(BfsTest, IgnoresEdgesToRemovedNodes) {
+    lightweight::Digraph<int> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.emplace_node(i);
+    }
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(0, 3);
+    graph.addEdge(3, 2);
+    graph.addEdge(3, 1);
+    // The digraph keeps the edges 0 -> 1 and 3 -> 1 until compact().
+    graph.removeNode(1);
+
+    std::vector<size_t> expected = {0, algorithms::UNREACHABLE, 2, 1};
+    EXPECT_EQ(algorithms::bfsDistances(graph, 0), expected);
+    EXPECT_EQ(algorithms::parallelBfsDistances(graph, 0, 4, 1), expected);
+}
+
+TEST(BfsTest, InvalidSourceThrows) {
+    lightweight::Graph<int> graph;
+    graph.emplace_node(0);
+    EXPECT_THROW(algorithms::bfsDistances(graph, 1), std::out_of_range);
+    EXPECT_THROW(algorithms::parallelBfsDistances(graph, 1, 4), std::out_of_range);
+}
+
+TEST(BfsTest, ParallelMatchesSequentialOnGraph) {
+    auto graph = randomGraph<lightweight::Graph<int>>(2000, 3000, 7);
+    std::vector<size_t> expected = algorithms::bfsDistances(graph, 0);
+    for (size_t threads = 1; threads <= 8; ++threads) {
+        EXPECT_EQ(algorithms::parallelBfsDistances(graph, 0, threads, 16), expected) << threads;
+    }
+}
+
+TEST(BfsTest, ParallelMatchesSequentialOnDigraph) {
+    auto graph = randomGraph<lightweight::Digraph<int>>(2000, 6000, 11);
+    for (size_t source : {0u, 17u, 1999u}) {
+        std::vector<size_t> expected = algorithms::bfsDistances(graph, source);
+        for (size_t threads = 2; threads <= 8; threads *= 2) {
+            EXPECT_EQ(algorithms::parallelBfsDistances(graph, source, threads, 8), expected);
+        }
+    }
+}
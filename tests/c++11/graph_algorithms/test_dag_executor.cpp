@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "dag_executor.hpp"
+#include "lightweight_digraph.hpp"
+
+using namespace vpr;
+
+using TaskGraph = lightweight::Digraph<int>;
+
+TEST(DagExecutorTest, RunsTasksAfterTheirPredecessors) {
+    const size_t n = 3000;
+    std::mt19937 rng(11);
+    TaskGraph dag;
+    std::vector<std::vector<size_t>> predecessors(n);
+    for (size_t i = 0; i < n; ++i) {
+        dag.emplace_node(static_cast<int>(i));
+    }
+    for (size_t v = 1; v < n; ++v) {
+        for (size_t k = rng() % 4; k > 0; --k) {
+            const size_t u = rng() % v;
+            dag.addEdge(u, v);
+            predecessors[v].push_back(u);
+        }
+    }
+
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[n]);
+    for (size_t i = 0; i < n; ++i) {
+        done[i].store(false);
+    }
+    std::atomic<size_t> violations(0);
+    parallel::ThreadPool pool(4);
+    auto report = algorithms::runDag(pool, dag, [&](const TaskGraph::Node& node) {
+        for (size_t u : predecessors[node.index()]) {
+            if (!done[u].load()) {
+                ++violations;
+            }
+        }
+        done[node.index()].store(true);
+    });
+
+    EXPECT_EQ(violations.load(), 0u);
+    EXPECT_TRUE(report.succeeded());
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_TRUE(done[i].load());
+        ASSERT_EQ(report.states[i], algorithms::TaskState::Succeeded);
+    }
+    ASSERT_FALSE(report.criticalPath.empty());
+    for (size_t k = 1; k < report.criticalPath.size(); ++k) {
+        EXPECT_TRUE(dag.hasEdge(report.criticalPath[k - 1], report.criticalPath[k]));
+    }
+}
+
+TEST(DagExecutorTest, CancelsTasksDownstreamOfFailures) {
+    // 0 -> 1 -> 3, 0 -> 2 -> 3, 3 -> 4 and an independent chain 5 -> 6.
+    TaskGraph dag;
+    for (int i = 0; i < 7; ++i) {
+        dag.emplace_node(i);
+    }
+    dag.addEdge(0, 1);
+    dag.addEdge(0, 2);
+    dag.addEdge(1, 3);
+    dag.addEdge(2, 3);
+    dag.addEdge(3, 4);
+    dag.addEdge(5, 6);
+
+    std::atomic<int> ran(0);
+    auto report = algorithms::runDag(dag, [&](const TaskGraph::Node& node) {
+        ++ran;
+        if (node.index() == 1) {
+            throw std::runtime_error("task 1 failed");
+        }
+    });
+    using algorithms::TaskState;
+    EXPECT_EQ(report.states, std::vector<TaskState>({ TaskState::Succeeded, TaskState::Failed, TaskState::Succeeded,
+                                                      TaskState::Cancelled, TaskState::Cancelled,
+                                                      TaskState::Succeeded, TaskState::Succeeded }));
+    EXPECT_EQ(ran.load(), 5);
+    EXPECT_EQ(report.failed, 1u);
+    EXPECT_EQ(report.cancelled, 2u);
+    EXPECT_FALSE(report.succeeded());
+    EXPECT_THROW(report.rethrowIfFailed(), std::runtime_error);
+
+    // With a single worker, sources start from the last one, so task 5 fails first.
+    parallel::ThreadPool single(1);
+    algorithms::DagOptions options;
+    options.cancelAllOnFailure = true;
+    report = algorithms::runDag(single, dag, [](const TaskGraph::Node& node) {
+        if (node.index() == 5) {
+            throw std::logic_error("task 5 failed");
+        }
+    }, options);
+    EXPECT_EQ(report.failed, 1u);
+    EXPECT_EQ(report.cancelled, 6u);
+    EXPECT_EQ(report.states[5], TaskState::Failed);
+}
+
+TEST(DagExecutorTest, ReportsCriticalPathAndRejectsCycles) {
+    TaskGraph dag;
+    for (int i = 0; i < 5; ++i) {
+        dag.emplace_node(i);
+    }
+    dag.addEdge(0, 1);
+    dag.addEdge(0, 2);
+    dag.addEdge(1, 3);
+    dag.addEdge(2, 3);
+    dag.addEdge(4, 3);
+    dag.removeNode(4);
+
+    parallel::ThreadPool pool(3);
+    auto report = algorithms::runDag(pool, dag, [](const TaskGraph::Node& node) {
+        if (node.index() == 2) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        }
+    });
+    EXPECT_EQ(report.criticalPath, std::vector<size_t>({ 0, 2, 3 }));
+    EXPECT_GE(report.criticalPathSeconds, 0.03);
+    EXPECT_GE(report.wallSeconds, report.criticalPathSeconds);
+    EXPECT_EQ(report.states[4], algorithms::TaskState::Skipped);
+
+    dag.addEdge(3, 0);
+    EXPECT_THROW(algorithms::runDag(pool, dag, [](const TaskGraph::Node&) {}), std::invalid_argument);
+}
+
+TEST(DagExecutorTest, IdleWorkersSleepDuringLongTasks) {
+    // A long task followed by a fan-out: the other workers have nothing to do until it ends.
+    TaskGraph dag;
+    for (int i = 0; i < 65; ++i) {
+        dag.emplace_node(i);
+    }
+    for (size_t v = 1; v < dag.size(); ++v) {
+        dag.addEdge(0, v);
+    }
+
+    parallel::ThreadPool pool(4);
+    std::atomic<int> ran(0);
+    const std::clock_t cpuBefore = std::clock();
+    auto report = algorithms::runDag(pool, dag, [&](const TaskGraph::Node& node) {
+        if (node.index() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
+        ++ran;
+    });
+    const double cpuSeconds = static_cast<double>(std::clock() - cpuBefore) / CLOCKS_PER_SEC;
+    EXPECT_TRUE(report.succeeded());
+    EXPECT_EQ(ran.load(), 65);
+    EXPECT_GE(report.wallSeconds, 0.3);
+    EXPECT_LT(cpuSeconds, 0.15);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include "lightweight_graph.hpp"
+#include "lightweight_digraph.hpp"
+
+using namespace vpr;
+using algorithms::ReorderStrategy;
+
+/**
+ * @brief Returns the set of (value, value) pairs connected by an edge.
+ */
+template <typename GraphType>
+std::multiset<std::pair<int, int>> edgeValues(const GraphType& graph) {
+    std::multiset<std::pair<int, int>> edges;
+    for (const auto& node : graph) {
+        for (size_t target : node.edges()) {
+            edges.insert(std::make_pair(node.value(), graph.getNode(target).value()));
+        }
+    }
+    return edges;
+}
+
+/**
+ * @brief Largest index distance between the endpoints of an edge.
+ */
+template <typename GraphType>
+size_t bandwidth(const GraphType& graph) {
+    size_t result = 0;
+    for (const auto& node : graph) {
+        for (size_t target : node.edges()) {
+            result = std::max(result, node.index() > target ? node.index() - target : target - node.index());
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Builds a 20x20 grid graph whose node ids are randomly shuffled.
+ */
+lightweight::Graph<int> shuffledGrid() {
+    const size_t side = 20;
+    std::vector<size_t> ids(side * side);
+    std::iota(ids.begin(), ids.end(), size_t(0));
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(3));
+
+    lightweight::Graph<int> graph;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        graph.emplace_node(static_cast<int>(i));
+    }
+    for (size_t r = 0; r < side; ++r) {
+        for (size_t c = 0; c < side; ++c) {
+            if (c + 1 < side) graph.addEdge(ids[r * side + c], ids[r * side + c + 1]);
+            if (r + 1 < side) graph.addEdge(ids[r * side + c], ids[(r + 1) * side + c]);
+        }
+    }
+    return graph;
+}
+
+TEST(ReorderTest, PermutationPreservesStructure) {
+    for (ReorderStrategy strategy : {ReorderStrategy::ReverseCuthillMcKee,
+                                     ReorderStrategy::DegreeDescending,
+                                     ReorderStrategy::BreadthFirst}) {
+        auto graph = shuffledGrid();
+        auto before = edgeValues(graph);
+        std::vector<int> values;
+        for (const auto& node : graph) {
+            values.push_back(node.value());
+        }
+
+        std::vector<size_t> permutation = graph.reorder(strategy);
+
+        EXPECT_EQ(edgeValues(graph), before);
+        for (size_t i = 0; i < permutation.size(); ++i) {
+            EXPECT_EQ(graph.getNode(permutation[i]).value(), values[i]);
+            EXPECT_EQ(graph.getNode(i).index(), i);
+        }
+    }
+}
+
+TEST(ReorderTest, ReverseCuthillMcKeeReducesBandwidth) {
+    auto graph = shuffledGrid();
+    size_t original = bandwidth(graph);
+    graph.reorder(ReorderStrategy::ReverseCuthillMcKee);
+    EXPECT_LT(bandwidth(graph), original);
+    EXPECT_LE(bandwidth(graph), 40);
+}
+
+TEST(ReorderTest, DegreeDescending) {
+    lightweight::Digraph<int> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.emplace_node(i);
+    }
+    graph.addEdge(3, 0);
+    graph.addEdge(3, 1);
+    graph.addEdge(3, 2);
+    graph.addEdge(1, 2);
+
+    std::vector<size_t> permutation = graph.reorder(ReorderStrategy::DegreeDescending);
+    EXPECT_EQ(permutation, std::vector<size_t>({2, 1, 3, 0}));
+    EXPECT_EQ(graph.getNode(0).value(), 3);
+    EXPECT_EQ(graph.getNode(0).degree(), 3);
+    EXPECT_TRUE(graph.hasEdge(1, 3));
+}
+
+TEST(ReorderTest, BreadthFirstKeepsNormalizedEdges) {
+    lightweight::Digraph<int> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.emplace_node(i);
+    }
+    graph.setAdjacencyMode(templates::AdjacencyMode::SortedUnique);
+    graph.addEdge(0, 3);
+    graph.addEdge(3, 1);
+    graph.addEdge(3, 2);
+
+    graph.reorder(ReorderStrategy::BreadthFirst);
+    std::vector<int> values;
+    for (const auto& node : graph) {
+        values.push_back(node.value());
+        EXPECT_TRUE(std::is_sorted(node.edges().begin(), node.edges().end()));
+    }
+    EXPECT_EQ(values, std::vector<int>({0, 3, 1, 2}));
+    EXPECT_TRUE(graph.isNormalized());
+}
+
+TEST(ReorderTest, RemovedNodesMoveToTheEnd) {
+    lightweight::Graph<int> graph;
+    for (int i = 0; i < 4; ++i) {
+        graph.emplace_node(i);
+    }
+    graph.addEdge(1, 2);
+    graph.removeNode(0);
+
+    std::vector<size_t> permutation = graph.reorder(ReorderStrategy::BreadthFirst);
+    EXPECT_EQ(permutation[0], 3);
+    EXPECT_TRUE(graph.isRemoved(3));
+    EXPECT_EQ(graph.liveSize(), 3);
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include "binary_format.hpp"
+#include "lightweight_digraph.hpp"
+#include "lightweight_graph.hpp"
+#include "lightweight_tree.hpp"
+#include "smart_tree.hpp"
+
+using namespace vpr;
+
+/**
+ * @brief Length-prefixed string serializer.
+ */
+struct StringSerializer {
+    void write(std::ostream& out, const std::string& value) const {
+        uint32_t size = static_cast<uint32_t>(value.size());
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(value.data(), size);
+    }
+
+    std::string read(std::istream& in) const {
+        uint32_t size = 0;
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::string value(size, '\0');
+        in.read(&value[0], size);
+        return value;
+    }
+};
+
+/**
+ * @brief Read-only stream buffer over a string that cannot seek, like a pipe.
+ */
+struct ForwardOnlyBuffer : std::streambuf {
+    std::string data;
+
+    explicit ForwardOnlyBuffer(std::string bytes) : data(std::move(bytes)) {
+        setg(&data[0], &data[0], &data[0] + data.size());
+    }
+};
+
+/**
+ * @brief Returns a copy of binary data with the header field at `offset` overwritten.
+ */
+std::string patchHeader(std::string bytes, size_t offset, uint64_t value) {
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+    return bytes;
+}
+
+template <typename GraphType>
+std::vector<std::vector<size_t>> adjacency(const GraphType& graph) {
+    std::vector<std::vector<size_t>> result;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        const auto& edges = graph.getNode(i).edges();
+        result.emplace_back(edges.begin(), edges.end());
+    }
+    return result;
+}
+
+TEST(BinaryFormatTest, TreeRoundTrip) {
+    lightweight::Tree<double> tree(0.5);
+    for (size_t i = 1; i < 1000; ++i) {
+        tree.addChild((i - 1) / 3, static_cast<double>(i) / 4);
+    }
+    tree.removeSubtree(2);
+
+    std::stringstream buffer;
+    io::saveTree(buffer, tree);
+    auto loaded = io::loadTree<lightweight::Tree<double>>(buffer);
+
+    tree.compact();
+    ASSERT_EQ(loaded.size(), tree.size());
+    EXPECT_EQ(adjacency(loaded), adjacency(tree));
+    for (size_t i = 0; i < tree.size(); ++i) {
+        EXPECT_EQ(loaded.getNode(i).value(), tree.getNode(i).value());
+        EXPECT_EQ(loaded.getNode(i).parentId(), tree.getNode(i).parentId());
+        EXPECT_EQ(loaded.depth(i), tree.depth(i));
+    }
+}
+
+TEST(BinaryFormatTest, SmartTreeWithSerializer) {
+    smart::Tree<std::string> tree("root");
+    size_t a = tree.addChild(0, "a");
+    tree.addChild(a, "a.1");
+    tree.addChild(0, "b");
+
+    std::stringstream buffer;
+    io::saveTree(buffer, tree, StringSerializer());
+    auto loaded = io::loadTree<smart::Tree<std::string>>(buffer, StringSerializer());
+
+    ASSERT_EQ(loaded.size(), 4u);
+    EXPECT_EQ(loaded.getNode(2).value(), "a.1");
+    EXPECT_EQ(loaded.getNode(2).parentId(), 1u);
+    EXPECT_EQ(loaded.getRoot().getChildren().size(), 2u);
+}
+
+TEST(BinaryFormatTest, GraphRoundTripSkipsRemovedNodes) {
+    lightweight::Graph<int> graph;
+    for (int i = 0; i < 6; ++i) {
+        graph.emplace_node(i * 10);
+    }
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 5);
+    graph.addEdge(3, 3);
+    graph.addEdge(4, 0);
+    graph.removeNode(1);
+
+    std::stringstream buffer;
+    io::saveGraph(buffer, graph);
+    auto loaded = io::loadGraph<lightweight::Graph<int>>(buffer);
+
+    graph.compact();
+    EXPECT_EQ(adjacency(loaded), adjacency(graph));
+    EXPECT_EQ(loaded.getNode(4).value(), 50);
+    EXPECT_EQ(loaded.isNormalized(), graph.isNormalized());
+    EXPECT_TRUE(loaded.hasEdge(3, 0));
+}
+
+TEST(BinaryFormatTest, DigraphKeepsAdjacencyMode) {
+    lightweight::Digraph<std::string> graph;
+    graph.emplace_node("x");
+    graph.emplace_node("y");
+    graph.emplace_node("z");
+    graph.setAdjacencyMode(templates::AdjacencyMode::SortedUnique);
+    graph.addEdge(0, 2);
+    graph.addEdge(0, 1);
+    graph.addEdge(2, 0);
+
+    std::stringstream buffer;
+    io::saveGraph(buffer, graph, StringSerializer());
+    auto loaded = io::loadGraph<lightweight::Digraph<std::string>>(buffer, StringSerializer());
+
+    EXPECT_EQ(adjacency(loaded), adjacency(graph));
+    EXPECT_EQ(loaded.adjacencyMode(), templates::AdjacencyMode::SortedUnique);
+    EXPECT_EQ(loaded.getNode(2).value(), "z");
+}
+
+TEST(BinaryFormatTest, RejectsMismatchedOrTruncatedData) {
+    lightweight::Digraph<int> graph;
+    graph.emplace_node(1);
+    graph.emplace_node(2);
+    graph.addEdge(0, 1);
+
+    std::stringstream buffer;
+    io::saveGraph(buffer, graph);
+    std::string bytes = buffer.str();
+
+    std::stringstream asTree(bytes);
+    EXPECT_THROW(io::loadTree<lightweight::Tree<int>>(asTree), std::runtime_error);
+    std::stringstream asDouble(bytes);
+    EXPECT_THROW(io::loadGraph<lightweight::Digraph<double>>(asDouble), std::runtime_error);
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 9));
+    EXPECT_THROW(io::loadGraph<lightweight::Digraph<int>>(truncated), std::runtime_error);
+    std::stringstream garbage(std::string(64, 'x'));
+    EXPECT_THROW(io::loadGraph<lightweight::Digraph<int>>(garbage), std::runtime_error);
+}
+
+TEST(BinaryFormatTest, RejectsCorruptCountsWithoutAllocating) {
+    lightweight::Digraph<int> graph;
+    graph.emplace_node(1);
+    graph.emplace_node(2);
+    graph.addEdge(0, 1);
+    std::stringstream buffer;
+    io::saveGraph(buffer, graph);
+    const std::string bytes = buffer.str();
+    const size_t nodeCountOffset = offsetof(io::FileHeader, nodeCount);
+    const size_t edgeCountOffset = offsetof(io::FileHeader, edgeCount);
+
+    for (uint64_t count : { uint64_t(1) << 40, std::numeric_limits<uint64_t>::max() / 8 + 1,
+                            std::numeric_limits<uint64_t>::max() }) {
+        for (size_t offset : { nodeCountOffset, edgeCountOffset }) {
+            const std::string corrupt = patchHeader(bytes, offset, count);
+            std::stringstream in(corrupt);
+            EXPECT_THROW(io::loadGraph<lightweight::Digraph<int>>(in), std::runtime_error) << count;
+            ForwardOnlyBuffer pipe(corrupt);
+            std::istream pipeIn(&pipe);
+            EXPECT_THROW(io::loadGraph<lightweight::Digraph<int>>(pipeIn), std::runtime_error) << count;
+        }
+    }
+
+    lightweight::Tree<int> tree(1);
+    tree.addChild(0, 2);
+    std::stringstream treeBuffer;
+    io::saveTree(treeBuffer, tree);
+    std::stringstream corruptTree(patchHeader(treeBuffer.str(), nodeCountOffset, uint64_t(1) << 40));
+    EXPECT_THROW(io::loadTree<lightweight::Tree<int>>(corruptTree), std::runtime_error);
+
+    // Valid data still loads from a stream that cannot seek.
+    ForwardOnlyBuffer pipe(bytes);
+    std::istream pipeIn(&pipe);
+    EXPECT_EQ(adjacency(io::loadGraph<lightweight::Digraph<int>>(pipeIn)), adjacency(graph));
+}
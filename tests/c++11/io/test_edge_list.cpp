@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "edge_list.hpp"
+#include "lightweight_digraph.hpp"
+#include "lightweight_graph.hpp"
+
+using namespace vpr;
+
+std::string writeTextFile(const std::string& name, const std::string& text) {
+    std::string path = testing::TempDir() + name;
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out << text;
+    return path;
+}
+
+template <typename GraphType>
+std::vector<std::vector<size_t>> edgeLists(const GraphType& graph) {
+    std::vector<std::vector<size_t>> result;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        const auto& edges = graph.getNode(i).edges();
+        result.emplace_back(edges.begin(), edges.end());
+    }
+    return result;
+}
+
+TEST(EdgeListTest, LoadsSnapDigraph) {
+    std::string path = writeTextFile("snap.txt",
+        "# Directed graph\n"
+        "# FromNodeId\tToNodeId\n"
+        "0\t1\n"
+        "0\t2\r\n"
+        "\n"
+        "2\t0\n"
+        "  3 3 0.5\n"
+        "1\t3");
+    std::vector<uint64_t> ids;
+    auto graph = io::loadEdgeList<lightweight::Digraph<int>>(path, ids);
+
+    std::vector<std::vector<size_t>> expected = { {1, 2}, {3}, {0}, {3} };
+    EXPECT_EQ(edgeLists(graph), expected);
+    EXPECT_EQ(ids, std::vector<uint64_t>({0, 1, 2, 3}));
+    std::remove(path.c_str());
+}
+
+TEST(EdgeListTest, RemapsSparseAndOneBasedIds) {
+    std::string path = writeTextFile("sparse.txt", "1000000000 7\n7 42\n");
+    std::vector<uint64_t> ids;
+    auto graph = io::loadEdgeList<lightweight::Graph<int>>(path, ids);
+    EXPECT_EQ(ids, std::vector<uint64_t>({7, 42, 1000000000}));
+    std::vector<std::vector<size_t>> expected = { {2, 1}, {0}, {0} };
+    EXPECT_EQ(edgeLists(graph), expected);
+    std::remove(path.c_str());
+
+    path = writeTextFile("matrix.mtx",
+        "%%MatrixMarket matrix coordinate pattern general\n"
+        "% comment\n"
+        "3 3 3\n"
+        "1 2\n"
+        "2 3\n"
+        "3 3\n");
+    auto digraph = io::loadEdgeList<lightweight::Digraph<int>>(path, ids);
+    EXPECT_EQ(ids, std::vector<uint64_t>({1, 2, 3}));
+    expected = { {1}, {2}, {2} };
+    EXPECT_EQ(edgeLists(digraph), expected);
+    std::remove(path.c_str());
+}
+
+TEST(EdgeListTest, ParallelParsingMatchesSerialParsing) {
+    std::ostringstream text;
+    lightweight::Graph<int> reference;
+    const size_t n = 5000;
+    for (size_t i = 0; i < n; ++i) {
+        reference.emplace_node(0);
+    }
+    for (size_t e = 0; e < 200000; ++e) {
+        size_t from = (e * 7919) % n;
+        size_t to = (e * 104729 + 13) % n;
+        text << from << '\t' << to << '\n';
+        reference.addEdge(from, to);
+    }
+    std::string path = writeTextFile("large.txt", text.str());
+
+    auto serial = io::loadEdgeList<lightweight::Graph<int>>(path, 1);
+    auto parallel = io::loadEdgeList<lightweight::Graph<int>>(path, 4);
+    EXPECT_EQ(edgeLists(serial), edgeLists(reference));
+    EXPECT_EQ(edgeLists(parallel), edgeLists(reference));
+    std::remove(path.c_str());
+}
+
+TEST(EdgeListTest, RejectsMalformedLines) {
+    std::string path = writeTextFile("malformed.txt", "0 1\n1 x\n");
+    EXPECT_THROW(io::loadEdgeList<lightweight::Digraph<int>>(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    path = writeTextFile("overflow.txt", "0 5\n18446744073709551616 7\n");
+    EXPECT_THROW(io::loadEdgeList<lightweight::Digraph<int>>(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    path = writeTextFile("largest.txt", "0 18446744073709551615\n");
+    std::vector<uint64_t> ids;
+    EXPECT_EQ(io::loadEdgeList<lightweight::Digraph<int>>(path, ids).size(), 2u);
+    EXPECT_EQ(ids, std::vector<uint64_t>({0, UINT64_MAX}));
+    std::remove(path.c_str());
+
+    path = writeTextFile("empty.txt", "# nothing\n");
+    EXPECT_EQ(io::loadEdgeList<lightweight::Digraph<int>>(path).size(), 0u);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "graph_export.hpp"
+#include "lightweight_digraph.hpp"
+#include "lightweight_graph.hpp"
+#include "lightweight_tree.hpp"
+
+using namespace vpr;
+
+struct Point {
+    int x;
+    int y;
+};
+
+struct FormatPoint {
+    void operator()(io::ValueSink& sink, const Point& p) const {
+        sink.put('(');
+        sink.writeInteger(p.x);
+        sink.write(", ");
+        sink.writeInteger(p.y);
+        sink.put(')');
+    }
+};
+
+TEST(GraphExportTest, TreeDotSkipsRemovedNodes) {
+    lightweight::Tree<std::string> tree("root");
+    size_t a = tree.addChild(0, "say \"hi\"");
+    tree.addChild(0, "b");
+    tree.addChild(a, "c");
+    tree.removeSubtree(2);
+
+    std::ostringstream out;
+    io::saveTreeDot(out, tree);
+    EXPECT_EQ(out.str(),
+              "digraph {\n"
+              "  0 [label=\"root\"];\n"
+              "  1 [label=\"say \\\"hi\\\"\"];\n"
+              "  3 [label=\"c\"];\n"
+              "  0 -> 1;\n"
+              "  1 -> 3;\n"
+              "}\n");
+}
+
+TEST(GraphExportTest, UndirectedGraphListsEachEdgeOnce) {
+    lightweight::Graph<double> graph;
+    graph.emplace_node(0.5);
+    graph.emplace_node(-2.0);
+    graph.emplace_node(0.1);
+    graph.addEdge(0, 1);
+    graph.addEdge(2, 1);
+    graph.addEdge(2, 2);
+
+    std::ostringstream out;
+    io::saveGraphDot(out, graph);
+    EXPECT_EQ(out.str(),
+              "graph {\n"
+              "  0 [label=\"0.5\"];\n"
+              "  1 [label=\"-2\"];\n"
+              "  2 [label=\"0.1\"];\n"
+              "  0 -- 1;\n"
+              "  1 -- 2;\n"
+              "  2 -- 2;\n"
+              "}\n");
+
+    std::ostringstream bare;
+    io::saveGraphDot(bare, graph, io::NoValues());
+    EXPECT_EQ(bare.str().find("label"), std::string::npos);
+}
+
+TEST(GraphExportTest, DigraphGraphMLWithCustomFormatter) {
+    lightweight::Digraph<Point> graph;
+    Point a = {1, 2};
+    Point b = {3, -4};
+    graph.emplace_node(a);
+    graph.emplace_node(b);
+    graph.addEdge(1, 0);
+
+    std::ostringstream out;
+    io::saveGraphGraphML(out, graph, FormatPoint());
+    EXPECT_EQ(out.str(),
+              "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+              "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+              "  <key id=\"value\" for=\"node\" attr.name=\"value\" attr.type=\"string\"/>\n"
+              "  <graph id=\"G\" edgedefault=\"directed\">\n"
+              "    <node id=\"n0\"><data key=\"value\">(1, 2)</data></node>\n"
+              "    <node id=\"n1\"><data key=\"value\">(3, -4)</data></node>\n"
+              "    <edge source=\"n1\" target=\"n0\"/>\n"
+              "  </graph>\n"
+              "</graphml>\n");
+}
+
+TEST(GraphExportTest, TreeGraphMLEscapesAndSpansBufferFlushes) {
+    lightweight::Tree<std::string> tree("a<b & c>");
+    for (size_t i = 1; i < 5000; ++i) {
+        tree.addChild(i - 1, "node");
+    }
+
+    std::ostringstream out;
+    io::saveTreeGraphML(out, tree);
+    const std::string text = out.str();
+    EXPECT_NE(text.find("<data key=\"value\">a&lt;b &amp; c&gt;</data>"), std::string::npos);
+    EXPECT_NE(text.find("<edge source=\"n4998\" target=\"n4999\"/>"), std::string::npos);
+    EXPECT_EQ(text.substr(text.size() - 22), "  </graph>\n</graphml>\n");
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "json_tree.hpp"
+
+using namespace vpr;
+
+/**
+ * @brief Records SAX events as a compact string.
+ */
+struct EventLog {
+    std::string events;
+    void onNull() { events += "n "; }
+    void onBoolean(bool value) { events += value ? "t " : "f "; }
+    void onNumber(double value) { events += std::to_string(static_cast<long long>(value)) + " "; }
+    void onString(const std::string& value) { events += "'" + value + "' "; }
+    void onKey(const std::string& key) { events += key + ": "; }
+    void onStartObject() { events += "{ "; }
+    void onEndObject() { events += "} "; }
+    void onStartArray() { events += "[ "; }
+    void onEndArray() { events += "] "; }
+};
+
+TEST(JsonTreeTest, ReportsSaxEvents) {
+    std::string text = " {\"a\": [1, -2, {}], \"b\": {\"c\": null, \"d\": true}, \"e\": [], \"f\": \"x\"} ";
+    EventLog log;
+    io::parseJson(text.data(), text.size(), log);
+    EXPECT_EQ(log.events, "{ a: [ 1 -2 { } ] b: { c: n d: t } e: [ ] f: 'x' } ");
+}
+
+TEST(JsonTreeTest, BuildsOneNodePerValue) {
+    auto tree = io::parseJsonTree("{\"name\": \"vpr\", \"tags\": [\"a\", false, 2.5e1], \"empty\": {}}");
+    ASSERT_EQ(tree.size(), 7u);
+
+    const io::JsonNode& root = tree.getRoot().value();
+    EXPECT_EQ(root.type, io::JsonType::Object);
+    EXPECT_EQ(tree.getRoot().edges().size(), 3u);
+
+    EXPECT_EQ(tree.getNode(1).value().key, "name");
+    EXPECT_EQ(tree.getNode(1).value().text, "vpr");
+    EXPECT_EQ(tree.getNode(2).value().type, io::JsonType::Array);
+    EXPECT_EQ(tree.getNode(2).value().key, "tags");
+    EXPECT_EQ(tree.getNode(3).value().text, "a");
+    EXPECT_TRUE(tree.getNode(3).value().key.empty());
+    EXPECT_EQ(tree.getNode(4).value().type, io::JsonType::Boolean);
+    EXPECT_FALSE(tree.getNode(4).value().boolean);
+    EXPECT_DOUBLE_EQ(tree.getNode(5).value().number, 25.0);
+    EXPECT_EQ(tree.getNode(5).parentId(), 2u);
+    EXPECT_EQ(tree.getNode(6).value().type, io::JsonType::Object);
+    EXPECT_EQ(tree.depth(5), 2u);
+
+    auto scalar = io::parseJsonTree("  -12  ");
+    ASSERT_EQ(scalar.size(), 1u);
+    EXPECT_EQ(scalar.getRoot().value().number, -12.0);
+}
+
+TEST(JsonTreeTest, DecodesEscapesAndDeepNesting) {
+    auto tree = io::parseJsonTree("[\"q\\\"\\\\\\/\\n\\u00e9\\ud83d\\ude00\"]");
+    EXPECT_EQ(tree.getNode(1).value().text, "q\"\\/\n\xc3\xa9\xf0\x9f\x98\x80");
+
+    const size_t depth = 100000;
+    std::string deep(depth, '[');
+    deep += std::string(depth, ']');
+    auto nested = io::parseJsonTree(deep);
+    EXPECT_EQ(nested.size(), depth);
+    EXPECT_EQ(nested.depth(depth - 1), depth - 1);
+}
+
+TEST(JsonTreeTest, LoadsFilesAndRejectsInvalidDocuments) {
+    std::string path = testing::TempDir() + "document.json";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << "{\"values\": [1, 2, 3]}";
+    }
+    auto tree = io::loadJsonTree(path);
+    EXPECT_EQ(tree.size(), 5u);
+    EXPECT_EQ(tree.getNode(4).value().number, 3.0);
+    std::remove(path.c_str());
+
+    const char* invalid[] = { "", "[1, 2", "{\"a\" 1}", "[1,]", "{\"a\": 1}}", "tru", "01", "\"\\ud800\"", "[\"a\nb\"]", "{1: 2}" };
+    for (const char* text : invalid) {
+        EXPECT_THROW(io::parseJsonTree(text), std::runtime_error) << text;
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "bfs.hpp"
+#include "lightweight_digraph.hpp"
+#include "lightweight_tree.hpp"
+#include "mapped_view.hpp"
+
+using namespace vpr;
+
+template <typename GraphType, typename Writer>
+std::string writeFlatFile(const std::string& name, const GraphType& graph, Writer writer) {
+    std::string path = testing::TempDir() + name;
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    writer(out, graph);
+    return path;
+}
+
+template <typename Iterator>
+std::vector<size_t> visitedIndices(Iterator first, Iterator last) {
+    std::vector<size_t> result;
+    for (; first != last; ++first) {
+        result.push_back(first->index());
+    }
+    return result;
+}
+
+TEST(MappedViewTest, TreeMatchesSourceTree) {
+    lightweight::Tree<double> tree(0.5);
+    for (size_t i = 1; i < 500; ++i) {
+        tree.addChild((i - 1) / 3, static_cast<double>(i) / 4);
+    }
+    tree.removeSubtree(3);
+    std::string path = writeFlatFile("mapped_tree.vprb", tree, io::saveFlatTree<lightweight::Tree<double>>);
+    tree.compact();
+
+    io::MappedTree<double> view(path);
+    ASSERT_EQ(view.size(), tree.size());
+    for (size_t i = 0; i < tree.size(); ++i) {
+        const auto& node = view.getNode(i);
+        const auto& edges = tree.getNode(i).edges();
+        EXPECT_EQ(node.value(), tree.getNode(i).value());
+        EXPECT_EQ(node.parentId(), tree.getNode(i).parentId());
+        EXPECT_EQ(std::vector<size_t>(node.edges().begin(), node.edges().end()),
+                  std::vector<size_t>(edges.begin(), edges.end()));
+        EXPECT_EQ(view.nextSibling(i), tree.nextSibling(i));
+        EXPECT_EQ(view.prevSibling(i), tree.prevSibling(i));
+    }
+
+    const lightweight::Tree<double>& source = tree;
+    EXPECT_EQ(visitedIndices(view.pre_order_begin(), view.pre_order_end()),
+              visitedIndices(source.pre_order_begin(), source.pre_order_end()));
+    EXPECT_EQ(visitedIndices(view.post_order_begin(), view.post_order_end()),
+              visitedIndices(source.post_order_begin(), source.post_order_end()));
+    EXPECT_EQ(visitedIndices(view.bfs_begin(), view.bfs_end()),
+              visitedIndices(source.bfs_begin(), source.bfs_end()));
+    EXPECT_EQ(visitedIndices(view.bfs_rbegin(), view.bfs_rend()),
+              visitedIndices(source.bfs_rbegin(), source.bfs_rend()));
+    EXPECT_EQ(visitedIndices(view.pre_order_rbegin(), view.pre_order_rend()),
+              visitedIndices(source.pre_order_rbegin(), source.pre_order_rend()));
+    EXPECT_THROW(view.getNode(view.size()), std::out_of_range);
+    std::remove(path.c_str());
+}
+
+TEST(MappedViewTest, GraphWorksWithGraphAlgorithms) {
+    lightweight::Digraph<int> graph;
+    for (int i = 0; i < 6; ++i) {
+        graph.emplace_node(i);
+    }
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 4);
+    graph.addEdge(4, 5);
+    graph.addEdge(3, 0);
+    std::string path = writeFlatFile("mapped_graph.vprb", graph, io::saveFlatGraph<lightweight::Digraph<int>>);
+
+    io::MappedGraph<int> view(path);
+    EXPECT_EQ(view.edgeCount(), 5u);
+    EXPECT_EQ(view.isNormalized(), graph.isNormalized());
+    EXPECT_EQ(algorithms::bfsDistances(view, 0), algorithms::bfsDistances(graph, 0));
+    EXPECT_EQ(view.getNode(4).value(), 4);
+    std::remove(path.c_str());
+}
+
+TEST(MappedViewTest, RejectsMismatchedOrTruncatedFiles) {
+    lightweight::Tree<int> tree(1);
+    tree.addChild(0, 2);
+    tree.addChild(0, 3);
+    std::string path = writeFlatFile("mapped_invalid.vprb", tree, io::saveFlatTree<lightweight::Tree<int>>);
+
+    EXPECT_THROW(io::MappedTree<double> view(path), std::runtime_error);
+    EXPECT_THROW(io::MappedGraph<int> view(path), std::runtime_error);
+    EXPECT_NO_THROW(io::MappedTree<int> view(path));
+
+    std::string bytes;
+    {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    EXPECT_THROW(io::MappedTree<int> view(path), std::runtime_error);
+
+    // Counts whose layout overflows are rejected as truncated rather than wrapping around.
+    for (uint64_t count : { uint64_t(1) << 62, static_cast<uint64_t>(-1) }) {
+        std::string corrupt = bytes;
+        std::memcpy(&corrupt[offsetof(io::FileHeader, nodeCount)], &count, sizeof(count));
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+        out.close();
+        EXPECT_THROW(io::MappedTree<int> view(path), std::runtime_error);
+    }
+    std::remove(path.c_str());
+    EXPECT_THROW(io::MappedTree<int> view(path), std::system_error);
+}
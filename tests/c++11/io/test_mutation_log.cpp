@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <system_error>
+#include <string>
+#include <vector>
+#include "lightweight_digraph.hpp"
+#include "lightweight_graph.hpp"
+#include "lightweight_tree.hpp"
+#include "mutation_log.hpp"
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+using namespace vpr;
+
+struct LengthPrefixedString {
+    void write(std::ostream& out, const std::string& value) const {
+        io::detail::putLogVarint(out, value.size());
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    std::string read(std::istream& in) const {
+        std::string value(static_cast<size_t>(io::detail::getLogVarint(in)), '\0');
+        in.read(&value[0], static_cast<std::streamsize>(value.size()));
+        return value;
+    }
+};
+
+template <typename GraphType>
+std::vector<std::vector<size_t>> logAdjacency(const GraphType& graph) {
+    std::vector<std::vector<size_t>> result;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        const auto& edges = graph.getNode(i).edges();
+        result.emplace_back(edges.begin(), edges.end());
+    }
+    return result;
+}
+
+void removeLogFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".snap").c_str());
+}
+
+TEST(MutationLogTest, RecoversTreeFromSnapshotAndLog) {
+    const std::string path = testing::TempDir() + "tree.wal";
+    removeLogFiles(path);
+    lightweight::Tree<int> tree(0);
+    tree.addChild(0, 1);
+    {
+        io::LogOptions options;
+        options.groupCommitBytes = 64;
+        io::TreeLog<lightweight::Tree<int>> log(tree, path, options);
+        for (int i = 2; i < 300; ++i) {
+            log.addChild(static_cast<size_t>(i / 3), i);
+        }
+        EXPECT_EQ(log.generation(), 1u);
+    }
+
+    auto recovered = io::recoverTree<lightweight::Tree<int>>(path);
+    ASSERT_EQ(recovered.size(), tree.size());
+    EXPECT_EQ(logAdjacency(recovered), logAdjacency(tree));
+    for (size_t i = 0; i < tree.size(); ++i) {
+        EXPECT_EQ(recovered.getNode(i).value(), tree.getNode(i).value());
+        EXPECT_EQ(recovered.depth(i), tree.depth(i));
+    }
+    removeLogFiles(path);
+}
+
+TEST(MutationLogTest, CommitsManuallyWithUnboundedGroupSize) {
+    const std::string path = testing::TempDir() + "manual.wal";
+    removeLogFiles(path);
+    lightweight::Tree<int> tree(0);
+    io::LogOptions options;
+    options.groupCommitBytes = SIZE_MAX;
+    io::TreeLog<lightweight::Tree<int>> log(tree, path, options);
+    for (int i = 1; i < 1000; ++i) {
+        log.addChild(static_cast<size_t>(i - 1), i);
+    }
+    EXPECT_EQ(log.pendingRecords(), 999u);
+    EXPECT_EQ(io::recoverTree<lightweight::Tree<int>>(path).size(), 1u);
+
+    log.commit();
+    EXPECT_EQ(log.pendingRecords(), 0u);
+    auto recovered = io::recoverTree<lightweight::Tree<int>>(path);
+    EXPECT_EQ(logAdjacency(recovered), logAdjacency(tree));
+    removeLogFiles(path);
+}
+
+TEST(MutationLogTest, SnapshotsStartNewGenerations) {
+    const std::string path = testing::TempDir() + "snapshots.wal";
+    removeLogFiles(path);
+    lightweight::Tree<std::string> tree("root");
+    io::LogOptions options;
+    options.sync = false;
+    options.groupCommitBytes = 1;
+    options.snapshotInterval = 10;
+    {
+        io::TreeLog<lightweight::Tree<std::string>, LengthPrefixedString> log(tree, path, options);
+        for (size_t i = 0; i < 25; ++i) {
+            log.addChild(i / 2, "node " + std::to_string(i));
+        }
+        EXPECT_EQ(log.generation(), 3u);
+    }
+    auto recovered = io::recoverTree<lightweight::Tree<std::string>>(path, LengthPrefixedString());
+    ASSERT_EQ(recovered.size(), 26u);
+    EXPECT_EQ(recovered.getNode(25).value(), "node 24");
+    EXPECT_EQ(recovered.getNode(25).parentId(), 12u);
+
+    // A new log on the recovered tree continues from the next generation.
+    io::TreeLog<lightweight::Tree<std::string>, LengthPrefixedString> next(recovered, path, options);
+    EXPECT_EQ(next.generation(), 4u);
+    removeLogFiles(path);
+}
+
+TEST(MutationLogTest, RecoversGraphsThroughBulkAssignment) {
+    const std::string path = testing::TempDir() + "graph.wal";
+    removeLogFiles(path);
+    lightweight::Graph<double> graph;
+    graph.emplace_node(0.5);
+    graph.emplace_node(1.5);
+    graph.addEdge(0, 1);
+    {
+        io::LogOptions options;
+        options.sync = false;
+        io::GraphLog<lightweight::Graph<double>> log(graph, path, options);
+        log.emplace_node(2.5);
+        log.addEdge(2, 0);
+        log.addEdge(2, 2);
+        log.emplace_node(3.5);
+        log.addEdge(1, 3);
+        log.commit();
+        EXPECT_EQ(log.pendingRecords(), 0u);
+    }
+    auto recovered = io::recoverGraph<lightweight::Graph<double>>(path);
+    EXPECT_EQ(logAdjacency(recovered), logAdjacency(graph));
+    EXPECT_EQ(recovered.getNode(3).value(), 3.5);
+    removeLogFiles(path);
+
+    lightweight::Digraph<std::string> digraph;
+    digraph.setAdjacencyMode(templates::AdjacencyMode::SortedUnique);
+    {
+        io::LogOptions options;
+        options.sync = false;
+        io::GraphLog<lightweight::Digraph<std::string>, LengthPrefixedString> log(digraph, path, options);
+        log.emplace_node("a");
+        log.emplace_node("b");
+        log.addEdge(0, 1);
+        log.addEdge(1, 0);
+        log.addEdge(0, 1);
+    }
+    auto recoveredDigraph = io::recoverGraph<lightweight::Digraph<std::string>>(path, LengthPrefixedString());
+    EXPECT_EQ(logAdjacency(recoveredDigraph), logAdjacency(digraph));
+    EXPECT_EQ(recoveredDigraph.getNode(1).value(), "b");
+    removeLogFiles(path);
+}
+
+TEST(MutationLogTest, IgnoresTornBatchesAndStaleLogs) {
+    const std::string path = testing::TempDir() + "torn.wal";
+    removeLogFiles(path);
+    lightweight::Digraph<int> graph;
+    io::LogOptions options;
+    options.sync = false;
+    {
+        io::GraphLog<lightweight::Digraph<int>> log(graph, path, options);
+        log.emplace_node(7);
+        log.commit();
+        log.emplace_node(8);
+        log.commit();
+    }
+    // Simulate a crash in the middle of a batch.
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::app);
+        const char partial[] = { 12, 0, 0, 0, 1, 2, 3, 4, 2 };
+        out.write(partial, sizeof(partial));
+    }
+    auto recovered = io::recoverGraph<lightweight::Digraph<int>>(path);
+    ASSERT_EQ(recovered.size(), 2u);
+    EXPECT_EQ(recovered.getNode(1).value(), 8);
+
+    // A log of an older generation than the snapshot is ignored.
+    std::string staleLog;
+    {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        staleLog.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        io::GraphLog<lightweight::Digraph<int>> log(recovered, path, options);
+    }
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << staleLog;
+    }
+    EXPECT_EQ(io::recoverGraph<lightweight::Digraph<int>>(path).size(), 2u);
+    removeLogFiles(path);
+    EXPECT_THROW(io::recoverGraph<lightweight::Digraph<int>>(path), std::runtime_error);
+}
+
+TEST(MutationLogTest, FailedCommitsLeaveNoTornBatch) {
+    const std::string path = testing::TempDir() + "failed.wal";
+    removeLogFiles(path);
+    lightweight::Tree<int> tree(0);
+    io::LogOptions options;
+    options.sync = false;
+    options.groupCommitBytes = 1 << 20;
+    {
+        io::TreeLog<lightweight::Tree<int>> log(tree, path, options);
+        for (int i = 1; i <= 10; ++i) {
+            log.addChild(0, i);
+        }
+        log.commit();
+
+        // Let the next batch be written only partially, as when the disk fills up.
+        struct stat info;
+        ASSERT_EQ(::stat(path.c_str(), &info), 0);
+        struct rlimit previous;
+        ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &previous), 0);
+        struct rlimit limited = previous;
+        limited.rlim_cur = static_cast<rlim_t>(info.st_size) + 8;
+        void (*handler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+        ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+        for (int i = 11; i <= 60; ++i) {
+            log.addChild(static_cast<size_t>(i) / 2, i);
+        }
+        EXPECT_THROW(log.commit(), std::system_error);
+        ::setrlimit(RLIMIT_FSIZE, &previous);
+        std::signal(SIGXFSZ, handler);
+
+        EXPECT_FALSE(log.failed());
+        EXPECT_EQ(log.pendingRecords(), 50u);
+        struct stat after;
+        ASSERT_EQ(::stat(path.c_str(), &after), 0);
+        EXPECT_EQ(after.st_size, info.st_size);
+
+        // The retry writes the pending records once, and later batches stay replayable.
+        log.commit();
+        EXPECT_EQ(log.pendingRecords(), 0u);
+        for (int i = 61; i <= 70; ++i) {
+            log.addChild(static_cast<size_t>(i) - 1, i);
+        }
+    }
+
+    auto recovered = io::recoverTree<lightweight::Tree<int>>(path);
+    ASSERT_EQ(recovered.size(), tree.size());
+    EXPECT_EQ(logAdjacency(recovered), logAdjacency(tree));
+    removeLogFiles(path);
+}
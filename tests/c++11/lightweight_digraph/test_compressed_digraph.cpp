@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "bfs.hpp"
+#include "compressed_digraph.hpp"
+#include "lightweight_digraph.hpp"
+
+using namespace vpr;
+
+lightweight::Digraph<int> localDigraph(size_t n, size_t degree, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> offset(-50, 50);
+    lightweight::Digraph<int> graph;
+    for (size_t i = 0; i < n; ++i) {
+        graph.emplace_node(static_cast<int>(i) * 2);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = 0; k < degree; ++k) {
+            long target = static_cast<long>(i) + offset(rng);
+            if (target >= 0 && target < static_cast<long>(n)) {
+                graph.addEdge(i, static_cast<size_t>(target));
+            }
+        }
+    }
+    graph.addEdge(0, n - 1);
+    return graph;
+}
+
+TEST(CompressedDigraphTest, DecodesSortedEdgeLists) {
+    auto graph = localDigraph(2000, 8, 3);
+    lightweight::CompressedDigraph<int> compressed(graph);
+
+    ASSERT_EQ(compressed.size(), graph.size());
+    size_t edges = 0;
+    for (size_t i = 0; i < graph.size(); ++i) {
+        const auto& source = graph.getNode(i).edges();
+        std::vector<size_t> expected(source.begin(), source.end());
+        std::sort(expected.begin(), expected.end());
+        auto range = compressed.getNode(i).edges();
+        EXPECT_EQ(std::vector<size_t>(range.begin(), range.end()), expected);
+        EXPECT_EQ(range.size(), expected.size());
+        EXPECT_EQ(compressed.getNode(i).value(), graph.getNode(i).value());
+        edges += expected.size();
+    }
+    EXPECT_EQ(compressed.edgeCount(), edges);
+    EXPECT_LT(compressed.adjacencyBytes(), edges * sizeof(size_t) / 2);
+    EXPECT_TRUE(compressed.hasEdge(0, 1999));
+    EXPECT_FALSE(compressed.hasEdge(1999, 0));
+    EXPECT_THROW(compressed.getNode(2000), std::out_of_range);
+}
+
+TEST(CompressedDigraphTest, WorksWithBfs) {
+    auto graph = localDigraph(5000, 4, 11);
+    lightweight::CompressedDigraph<int> compressed(graph);
+    EXPECT_EQ(algorithms::bfsDistances(compressed, 0), algorithms::bfsDistances(graph, 0));
+    EXPECT_EQ(algorithms::parallelBfsDistances(compressed, 17, 3, 64), algorithms::bfsDistances(graph, 17));
+}
+
+TEST(CompressedDigraphTest, BuildsFromCsrAndValidatesInput) {
+    std::vector<size_t> offsets = {0, 2, 2, 3};
+    std::vector<size_t> targets = {2, 0, 1};
+    lightweight::CompressedDigraph<char> compressed(std::vector<char>{'a', 'b', 'c'}, offsets, targets);
+    auto range = compressed.getNode(0).edges();
+    EXPECT_EQ(std::vector<size_t>(range.begin(), range.end()), std::vector<size_t>({0, 2}));
+    EXPECT_TRUE(compressed.getNode(1).isolated());
+    EXPECT_TRUE(compressed.hasEdge(2, 1));
+
+    targets[2] = 3;
+    EXPECT_THROW(lightweight::CompressedDigraph<char>(std::vector<char>{'a', 'b', 'c'}, offsets, targets), std::out_of_range);
+
+    lightweight::Digraph<int> graph;
+    graph.emplace_node(1);
+    graph.emplace_node(2);
+    graph.removeNode(0);
+    EXPECT_THROW(lightweight::CompressedDigraph<int> invalid(graph), std::invalid_argument);
+}
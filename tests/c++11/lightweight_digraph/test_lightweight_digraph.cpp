@@ -134,3 +134,57 @@ TEST_F(DigraphTest, IteratorMethods) {
     }
     EXPECT_EQ(sum, 6);  // Same result for reverse iteration
 }
+
+// Test edge membership in append mode
+TEST_F(DigraphTest, HasEdge) {
+    digraph.addEdge(0, 2);
+    digraph.addEdge(0, 1);
+    EXPECT_FALSE(digraph.isNormalized());
+    EXPECT_TRUE(digraph.hasEdge(0, 1));
+    EXPECT_TRUE(digraph.hasEdge(0, 2));
+    EXPECT_FALSE(digraph.hasEdge(1, 0));
+}
+
+// Test that switching to sorted mode normalizes existing edges
+TEST_F(DigraphTest, SwitchToSortedUniqueNormalizes) {
+    digraph.addEdge(0, 2);
+    digraph.addEdge(0, 1);
+    digraph.addEdge(0, 2);
+    digraph.setAdjacencyMode(templates::AdjacencyMode::SortedUnique);
+    const auto& edges0 = digraph.getNode(0).edges();
+    EXPECT_EQ(std::vector<size_t>(edges0.begin(), edges0.end()), std::vector<size_t>({1, 2}));
+
+    digraph.addEdge(0, 0);
+    digraph.addEdge(0, 1);
+    EXPECT_EQ(std::vector<size_t>(edges0.begin(), edges0.end()), std::vector<size_t>({0, 1, 2}));
+}
+
+// Test that removed nodes are skipped and incoming edges are pruned by compact
+TEST_F(DigraphTest, RemoveNodeAndCompact) {
+    digraph.addEdge(0, 1);
+    digraph.addEdge(1, 2);
+    digraph.addEdge(2, 1);
+    digraph.addEdge(2, 0);
+
+    EXPECT_TRUE(digraph.removeNode(1));
+    EXPECT_FALSE(digraph.hasEdge(0, 1));
+    EXPECT_TRUE(digraph.hasEdge(2, 0));
+    EXPECT_THROW(digraph.addEdge(0, 1), std::invalid_argument);
+    EXPECT_THROW(digraph.addEdge(1, 0), std::invalid_argument);
+
+    std::stringstream output;
+    output << digraph;
+    EXPECT_EQ(output.str(), "1 3 ");
+
+    int sum = 0;
+    for (auto it = digraph.rbegin(); it != digraph.rend(); ++it) {
+        sum += it->value();
+    }
+    EXPECT_EQ(sum, 4);
+
+    digraph.compact();
+    EXPECT_EQ(digraph.size(), 2);
+    EXPECT_TRUE(digraph.getNode(0).isolated());
+    EXPECT_EQ(digraph.getNode(1).degree(), 1);
+    EXPECT_TRUE(digraph.hasEdge(1, 0));
+}
@@ -137,3 +137,93 @@ TEST_F( LightweightGraphTest, IteratorMethods) {
     }
     EXPECT_EQ(sum, 6);  // Same result for reverse iteration
 }
+
+// Test that a self-loop is stored only once
+TEST_F( LightweightGraphTest, SelfLoopStoredOnce) {
+    graph.addEdge(1, 1);
+    EXPECT_EQ(graph.getNode(1).degree(), 1);
+    EXPECT_TRUE(graph.hasEdge(1, 1));
+}
+
+// Test sorted and unique adjacency mode
+TEST_F( LightweightGraphTest, SortedUniqueAdjacency) {
+    graph.setAdjacencyMode(templates::AdjacencyMode::SortedUnique);
+    graph.addEdge(0, 2);
+    graph.addEdge(0, 1);
+    graph.addEdge(2, 0);
+
+    const auto& edges0 = graph.getNode(0).edges();
+    EXPECT_EQ(std::vector<size_t>(edges0.begin(), edges0.end()), std::vector<size_t>({1, 2}));
+    const auto& edges2 = graph.getNode(2).edges();
+    EXPECT_EQ(std::vector<size_t>(edges2.begin(), edges2.end()), std::vector<size_t>({0}));
+    EXPECT_TRUE(graph.isNormalized());
+    EXPECT_TRUE(graph.hasEdge(1, 0));
+    EXPECT_FALSE(graph.hasEdge(1, 2));
+}
+
+// Test normalize after bulk loading in append mode
+TEST_F( LightweightGraphTest, NormalizeAfterBulkLoad) {
+    for (int i = 0; i < 3000; ++i) {
+        graph.emplace_node(i);
+    }
+    for (size_t i = 0; i < graph.size(); ++i) {
+        graph.addEdge(i, (i * 7) % graph.size());
+        graph.addEdge(i, (i * 7) % graph.size());
+        graph.addEdge(i, (i + 1) % graph.size());
+    }
+    EXPECT_FALSE(graph.isNormalized());
+    EXPECT_TRUE(graph.hasEdge(5, 35));
+
+    graph.normalize(4);
+    EXPECT_TRUE(graph.isNormalized());
+    for (const auto& node : graph) {
+        EXPECT_TRUE(std::is_sorted(node.edges().begin(), node.edges().end()));
+        EXPECT_EQ(std::adjacent_find(node.edges().begin(), node.edges().end()), node.edges().end());
+    }
+    EXPECT_TRUE(graph.hasEdge(5, 35));
+    EXPECT_TRUE(graph.hasEdge(35, 5));
+    EXPECT_TRUE(graph.hasEdge(5, 6));
+    EXPECT_FALSE(graph.hasEdge(5, 7));
+    EXPECT_THROW(graph.hasEdge(graph.size(), 0), std::out_of_range);
+}
+
+// Test removing edges and nodes, then compacting the graph
+TEST_F( LightweightGraphTest, RemoveAndCompact) {
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(0, 2);
+
+    EXPECT_TRUE(graph.removeEdge(1, 0));
+    EXPECT_FALSE(graph.removeEdge(1, 0));
+    EXPECT_FALSE(graph.hasEdge(0, 1));
+
+    EXPECT_TRUE(graph.removeNode(1));
+    EXPECT_FALSE(graph.removeNode(1));
+    EXPECT_EQ(graph.liveSize(), 2);
+    EXPECT_FALSE(graph.hasEdge(2, 1));
+    EXPECT_EQ(graph.getNode(2).degree(), 1);
+    EXPECT_THROW(graph.addEdge(2, 1), std::invalid_argument);
+    EXPECT_EQ(graph.getNode(2).degree(), 1);
+
+    int sum = 0;
+    for (const auto& node : graph) {
+        sum += node.value();
+    }
+    EXPECT_EQ(sum, 4);
+    EXPECT_EQ(std::distance(graph.begin(), graph.end()), 2);
+    EXPECT_EQ(std::prev(graph.end())->value(), 3);
+    EXPECT_EQ((--std::prev(graph.end()))->value(), 1);
+    EXPECT_EQ(graph.rbegin()->value(), 3);
+    EXPECT_EQ(std::next(graph.rbegin())->value(), 1);
+    EXPECT_EQ(std::prev(graph.rend())->value(), 1);
+    EXPECT_EQ(graph.nodes().size(), 3);
+    EXPECT_EQ(graph.nodes()[2].value(), 3);
+
+    std::vector<size_t> remap = graph.compact();
+    EXPECT_EQ(remap, std::vector<size_t>({0, static_cast<size_t>(-1), 1}));
+    EXPECT_EQ(graph.size(), 2);
+    EXPECT_EQ(graph.getNode(1).value(), 3);
+    EXPECT_EQ(graph.getNode(1).index(), 1);
+    EXPECT_TRUE(graph.hasEdge(0, 1));
+    EXPECT_TRUE(graph.hasEdge(1, 0));
+}
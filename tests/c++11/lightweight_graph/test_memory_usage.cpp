@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "lightweight_graph.hpp"
+#include "lightweight_tree.hpp"
+
+using namespace vpr;
+
+TEST(MemoryUsageTest, GraphBreakdownAndCapacityControls) {
+    using Graph = lightweight::Graph<std::string>;
+    Graph graph;
+    graph.reserve(100);
+    for (int i = 0; i < 10; ++i) {
+        graph.emplace_node(std::string(100, 'a'));
+    }
+    graph.reserveEdges(40);
+    for (size_t i = 1; i < graph.size(); ++i) {
+        graph.addEdge(i - 1, i);
+    }
+
+    auto usage = graph.memoryUsage();
+    EXPECT_EQ(usage.nodeBytes, 10 * sizeof(Graph::Node));
+    EXPECT_EQ(usage.nodeSlackBytes, 90 * sizeof(Graph::Node));
+    EXPECT_EQ(usage.edgeBytes, 18 * sizeof(size_t));
+    EXPECT_EQ(usage.edgeSlackBytes, (40 - 18) * sizeof(size_t));
+    EXPECT_EQ(usage.valueHeapBytes, 0u);
+    EXPECT_EQ(usage.total(), usage.nodeBytes + usage.edgeBytes + usage.slackBytes() + usage.auxiliaryBytes);
+
+    auto withValues = graph.memoryUsage([](const std::string& value) { return value.capacity() + 1; });
+    EXPECT_GE(withValues.valueHeapBytes, 10 * 101u);
+    EXPECT_EQ(withValues.total(), usage.total() + withValues.valueHeapBytes);
+
+    graph.shrink_to_fit();
+    usage = graph.memoryUsage();
+    EXPECT_EQ(usage.nodeSlackBytes, 0u);
+    EXPECT_EQ(usage.edgeSlackBytes, 0u);
+    EXPECT_EQ(usage.edgeBytes, 18 * sizeof(size_t));
+    const auto& edges = graph.getNode(5).edges();
+    EXPECT_EQ(std::vector<size_t>(edges.begin(), edges.end()), std::vector<size_t>({ 4, 6 }));
+
+    std::vector<size_t> degrees(graph.size(), 0);
+    degrees[3] = 50;
+    graph.reserveEdges(degrees);
+    EXPECT_GE(graph.getNode(3).edges().capacity(), 50u);
+    EXPECT_EQ(graph.getNode(4).edges().capacity(), 2u);
+    EXPECT_THROW(graph.reserveEdges(std::vector<size_t>(3, 1)), std::invalid_argument);
+}
+
+TEST(MemoryUsageTest, TreeCountsItsColumns) {
+    lightweight::Tree<int> tree(0, 1000);
+    for (size_t i = 1; i < 100; ++i) {
+        tree.addChild((i - 1) / 2, static_cast<int>(i));
+    }
+    auto usage = tree.memoryUsage();
+    EXPECT_EQ(usage.nodeBytes, 100 * sizeof(lightweight::Tree<int>::Node));
+    EXPECT_EQ(usage.nodeSlackBytes, 900 * sizeof(lightweight::Tree<int>::Node));
+    EXPECT_EQ(usage.edgeBytes, 99 * sizeof(size_t));
+    EXPECT_GE(usage.auxiliaryBytes, 2 * 100 * sizeof(size_t));
+
+    tree.shrink_to_fit();
+    usage = tree.memoryUsage();
+    EXPECT_EQ(usage.nodeSlackBytes, 0u);
+    EXPECT_EQ(usage.edgeSlackBytes, 0u);
+    EXPECT_EQ(usage.auxiliaryBytes, 2 * 100 * sizeof(size_t));
+    EXPECT_EQ(tree.depth(99), 6u);
+
+    lightweight::StableTree<int> stable(0);
+    for (size_t i = 1; i < 100; ++i) {
+        stable.addChild(0, static_cast<int>(i));
+    }
+    stable.shrink_to_fit();
+    usage = stable.memoryUsage([](int) { return size_t(4); });
+    EXPECT_EQ(usage.valueHeapBytes, 400u);
+    EXPECT_EQ(usage.edgeSlackBytes, 0u);
+    EXPECT_EQ(usage.nodeBytes, 100 * sizeof(lightweight::StableTree<int>::Node));
+}
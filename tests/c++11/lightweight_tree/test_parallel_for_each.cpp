@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "lightweight_graph.hpp"
+#include "lightweight_tree.hpp"
+#include "thread_pool.hpp"
+
+using namespace vpr;
+
+TEST(ParallelForEachTest, ThreadPoolRunsTeamsAndNestedJobs) {
+    parallel::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+    for (size_t round = 0; round < 20; ++round) {
+        std::vector<std::atomic<int>> calls(4);
+        for (auto& count : calls) {
+            count.store(0);
+        }
+        std::atomic<int> nested(0);
+        pool.run(3, [&](size_t worker) {
+            ++calls[worker];
+            // A job issued from inside a job runs inline on the calling worker.
+            pool.run(4, [&](size_t inner) {
+                EXPECT_EQ(inner, 0u);
+                ++nested;
+            });
+        });
+        EXPECT_EQ(calls[0].load() + calls[1].load() + calls[2].load(), 3);
+        EXPECT_EQ(calls[3].load(), 0);
+        EXPECT_EQ(nested.load(), 3);
+    }
+    EXPECT_TRUE(parallel::IsExecutor<parallel::ThreadPool>::value);
+    EXPECT_FALSE(parallel::IsExecutor<size_t>::value);
+}
+
+TEST(ParallelForEachTest, VisitsEveryLiveNodeOnce) {
+    lightweight::Graph<int> graph;
+    for (int i = 0; i < 10000; ++i) {
+        graph.emplace_node(i);
+    }
+    for (size_t i = 1; i < graph.size(); ++i) {
+        graph.addEdge(i - 1, i);
+    }
+    graph.removeNode(17);
+
+    parallel::ThreadPool pool(4);
+    graph.parallel_for_each_node(pool, [](lightweight::Graph<int>::Node& node) {
+        node.value() = 2 * node.value() + static_cast<int>(node.degree());
+    }, 100);
+    EXPECT_EQ(graph.getNode(0).value(), 1);
+    EXPECT_EQ(graph.getNode(17).value(), 17);
+    EXPECT_EQ(graph.getNode(18).value(), 37);
+    EXPECT_EQ(graph.getNode(5000).value(), 10002);
+
+    std::atomic<size_t> visited(0);
+    const auto& constGraph = graph;
+    constGraph.parallel_for_each_node([&](const lightweight::Graph<int>::Node&) { ++visited; });
+    EXPECT_EQ(visited.load(), graph.liveSize());
+
+    EXPECT_THROW(graph.parallel_for_each_node(pool, [](lightweight::Graph<int>::Node& node) {
+        if (node.index() == 4321) {
+            throw std::runtime_error("failed");
+        }
+    }, 10), std::runtime_error);
+}
+
+TEST(ParallelForEachTest, SubtreesAreProcessedAfterTheirParents) {
+    std::mt19937 rng(7);
+    lightweight::Tree<size_t> tree(0);
+    for (size_t i = 1; i < 20000; ++i) {
+        // Mostly shallow attachments with a few long chains.
+        const size_t parent = i % 50 == 0 ? i - 1 : rng() % i;
+        tree.addChild(parent, 0);
+    }
+    tree.removeSubtree(3);
+
+    parallel::ThreadPool pool(4);
+    for (size_t grain : { size_t(1), size_t(16), size_t(1024), size_t(100000) }) {
+        tree.parallel_for_each_subtree(pool, [&tree](lightweight::Tree<size_t>::Node& node) {
+            node.value() = node.isRoot() ? 1 : tree.getNode(node.parentId()).value() + 1;
+        }, grain);
+        for (size_t i = 0; i < tree.size(); ++i) {
+            if (!tree.isRemoved(i)) {
+                ASSERT_EQ(tree.getNode(i).value(), tree.depth(i) + 1) << "grain " << grain;
+            }
+        }
+        tree.parallel_for_each_node(pool, [](lightweight::Tree<size_t>::Node& node) { node.value() = 0; });
+    }
+
+    std::atomic<size_t> visited(0);
+    const auto& constTree = tree;
+    constTree.parallel_for_each_subtree([&](const lightweight::Tree<size_t>::Node&) { ++visited; }, 64);
+    EXPECT_EQ(visited.load(), tree.liveSize());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "graph_template.hpp"
+#include "lightweight_tree.hpp"
+#include "node_template.hpp"
+#include "segmented_vector.hpp"
+
+using namespace vpr;
+
+class SegmentedDigraph : public templates::Graph<templates::Node<int, std::vector>, templates::SegmentedVector> {
+public:
+    using templates::Graph<templates::Node<int, std::vector>, templates::SegmentedVector>::addEdge;
+};
+
+TEST(SegmentedVectorTest, GrowsWithoutMovingElements) {
+    templates::SegmentedVector<std::string> values;
+    values.emplace_back("first");
+    const std::string* first = &values[0];
+    std::vector<const std::string*> addresses;
+    for (size_t i = 0; i < 5000; ++i) {
+        addresses.push_back(&values.emplace_back(std::to_string(i)));
+    }
+    EXPECT_EQ(&values[0], first);
+    EXPECT_EQ(*first, "first");
+    ASSERT_EQ(values.size(), 5001u);
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        ASSERT_EQ(&values[i + 1], addresses[i]);
+        ASSERT_EQ(values[i + 1], std::to_string(i));
+    }
+    // Block boundaries: 64, 64 + 128, 64 + 128 + 256...
+    EXPECT_EQ(values[63], "62");
+    EXPECT_EQ(values[64], "63");
+    EXPECT_EQ(values[191], "190");
+    EXPECT_EQ(values[192], "191");
+    EXPECT_THROW(values.at(5001), std::out_of_range);
+
+    EXPECT_EQ(std::distance(values.begin(), values.end()), 5001);
+    EXPECT_EQ(*values.rbegin(), "4999");
+    EXPECT_EQ(values.end() - 1 - values.begin(), 5000);
+    templates::SegmentedVector<std::string>::const_iterator it = values.begin() + 65;
+    EXPECT_EQ(it[-1], "63");
+
+    const size_t capacity = values.capacity();
+    while (values.size() > 10) {
+        values.pop_back();
+    }
+    EXPECT_EQ(values.capacity(), capacity);
+    values.shrink_to_fit();
+    EXPECT_EQ(values.capacity(), 64u);
+    EXPECT_EQ(values.back(), "8");
+}
+
+TEST(SegmentedVectorTest, CopiesAndMoves) {
+    templates::SegmentedVector<int> values;
+    values.reserve(100);
+    EXPECT_EQ(values.capacity(), 192u);
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+
+    templates::SegmentedVector<int> copy(values);
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), copy.begin()));
+
+    const int* address = &values[70];
+    templates::SegmentedVector<int> moved(std::move(values));
+    EXPECT_EQ(&moved[70], address);
+    EXPECT_TRUE(values.empty());
+
+    copy.clear();
+    copy = moved;
+    EXPECT_EQ(copy.size(), 100u);
+    moved.swap(values);
+    EXPECT_EQ(&values[70], address);
+    EXPECT_EQ(moved.size(), 0u);
+}
+
+TEST(SegmentedVectorTest, StableTreeKeepsNodeReferences) {
+    lightweight::StableTree<int> tree(0);
+    auto& root = tree.getRoot();
+    for (int i = 1; i < 2000; ++i) {
+        tree.addChild(static_cast<size_t>(i - 1) / 4, i);
+    }
+    EXPECT_EQ(&root, &tree.getRoot());
+    EXPECT_EQ(root.nChildren(), 4u);
+    EXPECT_EQ(tree.getNode(1999).parentId(), 499u);
+    EXPECT_EQ(tree.depth(1999), 6u);
+
+    lightweight::Tree<int> reference(0);
+    for (int i = 1; i < 2000; ++i) {
+        reference.addChild(static_cast<size_t>(i - 1) / 4, i);
+    }
+    std::vector<int> stableOrder;
+    std::vector<int> referenceOrder;
+    for (auto it = tree.pre_order_begin(); it != tree.pre_order_end(); ++it) {
+        stableOrder.push_back(it->value());
+    }
+    for (auto it = reference.pre_order_begin(); it != reference.pre_order_end(); ++it) {
+        referenceOrder.push_back(it->value());
+    }
+    EXPECT_EQ(stableOrder, referenceOrder);
+
+    const size_t removed = tree.removeSubtree(1);
+    auto remap = tree.compact();
+    EXPECT_EQ(remap[1], static_cast<size_t>(-1));
+    EXPECT_EQ(tree.size(), reference.size() - removed);
+    EXPECT_EQ(tree.getRoot().nChildren(), 3u);
+}
+
+TEST(SegmentedVectorTest, PlugsIntoGraphTemplate) {
+    SegmentedDigraph graph;
+    for (int i = 0; i < 300; ++i) {
+        graph.emplace_node(i);
+    }
+    const auto* node = &graph.getNode(10);
+    for (size_t i = 0; i < 300; ++i) {
+        graph.addEdge(i, (i * 7) % 300);
+        graph.addEdge(i, (i + 1) % 300);
+    }
+    EXPECT_EQ(node, &graph.getNode(10));
+    EXPECT_TRUE(graph.hasEdge(10, 70));
+    size_t count = 0;
+    for (const auto& n : graph) {
+        count += n.degree();
+    }
+    EXPECT_EQ(count, 600u);
+}
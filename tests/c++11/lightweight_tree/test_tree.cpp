@@ -81,4 +81,238 @@ TEST_F(LightweightTreeTest, TestShouldNotCompile) {
 }
 */
 
+TEST_F(LightweightTreeTest, TestRemoveSubtree) {
+    EXPECT_EQ(tree.removeSubtree(1), 3);
+    EXPECT_EQ(tree.size(), 7);
+    EXPECT_EQ(tree.liveSize(), 4);
+    EXPECT_TRUE(tree.isRemoved(3));
+    EXPECT_EQ(tree.getRoot().nChildren(), 1);
+    EXPECT_EQ(tree.removeSubtree(1), 0);
+    EXPECT_THROW(tree.removeSubtree(0), std::invalid_argument);
+    EXPECT_THROW(tree.addChild(1, "7"), std::invalid_argument);
+    EXPECT_THROW(tree.addChild(3, "7"), std::invalid_argument);
+    EXPECT_EQ(tree.size(), 7);
+    EXPECT_EQ(tree.liveSize(), 4);
+
+    std::vector<std::string> values;
+    for (auto it = tree.pre_order_begin(); it != tree.pre_order_end(); ++it) {
+        values.push_back(it->value());
+    }
+    EXPECT_EQ(values, std::vector<std::string>({"0", "2", "5", "6"}));
+
+    values.clear();
+    for (const auto& node : tree) {
+        values.push_back(node.value());
+    }
+    EXPECT_EQ(values, std::vector<std::string>({"0", "2", "5", "6"}));
+}
+
+TEST_F(LightweightTreeTest, TestCompactAfterRemoval) {
+    tree.removeSubtree(1);
+    std::vector<size_t> remap = tree.compact();
+    const size_t npos = static_cast<size_t>(-1);
+    EXPECT_EQ(remap, std::vector<size_t>({0, npos, 1, npos, npos, 2, 3}));
+    EXPECT_EQ(tree.size(), 4);
+    EXPECT_EQ(tree.liveSize(), 4);
+
+    for (size_t i = 0; i < tree.size(); ++i) {
+        EXPECT_EQ(tree.getNode(i).index(), i);
+    }
+    EXPECT_EQ(tree.getNode(1).value(), "2");
+    EXPECT_EQ(tree.getNode(1).parentId(), 0);
+    EXPECT_EQ(tree.getNode(3).value(), "6");
+    EXPECT_EQ(tree.getNode(3).parentId(), 1);
+
+    size_t child = tree.addChild(3, "7");
+    EXPECT_EQ(child, 4);
+    std::vector<std::string> values;
+    for (auto it = tree.post_order_begin(); it != tree.post_order_end(); ++it) {
+        values.push_back(it->value());
+    }
+    EXPECT_EQ(values, std::vector<std::string>({"5", "7", "6", "2", "0"}));
+}
+
+TEST_F(LightweightTreeTest, TestDepth) {
+    EXPECT_EQ(tree.depth(0), 0);
+    EXPECT_EQ(tree.depth(2), 1);
+    EXPECT_EQ(tree.depth(6), 2);
+    size_t deep = tree.addChild(6, "7");
+    EXPECT_EQ(tree.depth(deep), 3);
+    EXPECT_THROW(tree.depth(100), std::out_of_range);
+
+    tree.removeSubtree(1);
+    tree.compact();
+    EXPECT_EQ(tree.depth(1), 1);
+    EXPECT_EQ(tree.depth(4), 3);
+}
+
+TEST_F(LightweightTreeTest, TestReduceSubtrees) {
+    auto sizes = tree.reduce_subtrees(
+        [](const Node&) { return size_t(1); },
+        [](size_t& acc, size_t child) { acc += child; });
+    EXPECT_EQ(sizes, std::vector<size_t>({7, 3, 3, 1, 1, 1, 1}));
+
+    auto concatenated = tree.reduce_subtrees(
+        [](const Node& node) { return node.value(); },
+        [](std::string& acc, const std::string& child) { acc += child; }, 1);
+    EXPECT_EQ(concatenated[0], "0134256");
+
+    tree.removeSubtree(2);
+    sizes = tree.reduce_subtrees(
+        [](const Node&) { return size_t(1); },
+        [](size_t& acc, size_t child) { acc += child; });
+    EXPECT_EQ(sizes, std::vector<size_t>({4, 3, 0, 1, 1, 0, 0}));
+}
+
+TEST_F(LightweightTreeTest, TestParallelReduceSubtreesMatchesSequential) {
+    lightweight::Tree<int> big(0);
+    for (size_t i = 1; i < 20000; ++i) {
+        big.addChild((i - 1) / 8, static_cast<int>(i % 100));
+    }
+    auto leaf = [](const lightweight::Tree<int>::Node& node) { return static_cast<long>(node.value()); };
+    auto maxOf = [](long& acc, long child) { acc = std::max(acc, child) + 1; };
+
+    auto sequential = big.reduce_subtrees(leaf, maxOf, 1);
+    for (size_t threads = 2; threads <= 4; ++threads) {
+        EXPECT_EQ(big.reduce_subtrees(leaf, maxOf, threads, 16), sequential);
+    }
+}
+
+TEST_F(LightweightTreeTest, TestParallelReduceSubtreesRethrows) {
+    lightweight::Tree<int> star(0);
+    for (size_t i = 1; i < 20000; ++i) {
+        star.addChild(0, static_cast<int>(i));
+    }
+    auto add = [](long& acc, long child) { acc += child; };
+    for (size_t bad : {size_t(0), size_t(1), size_t(12345)}) {
+        auto leaf = [bad](const lightweight::Tree<int>::Node& node) -> long {
+            if (node.index() == bad) {
+                throw std::runtime_error("bad node");
+            }
+            return 1;
+        };
+        EXPECT_THROW(star.reduce_subtrees(leaf, add, 4, 64), std::runtime_error);
+    }
+    auto one = [](const lightweight::Tree<int>::Node&) { return long(1); };
+    auto failingAdd = [](long&, long) { throw std::runtime_error("bad combine"); };
+    EXPECT_THROW(star.reduce_subtrees(one, failingAdd, 4, 64), std::runtime_error);
+    EXPECT_EQ(star.reduce_subtrees(one, add, 4, 64)[0], 20000);
+}
+
+TEST_F(LightweightTreeTest, TestExtractSubtree) {
+    tree.addChild(4, "7");
+    auto extracted = tree.extractSubtree(1);
+
+    EXPECT_EQ(extracted.size(), 4);
+    EXPECT_EQ(extracted.getRoot().value(), "1");
+    EXPECT_EQ(extracted.getRoot().parentId(), 0);
+    EXPECT_EQ(extracted.getNode(3).value(), "7");
+    EXPECT_EQ(extracted.getNode(3).parentId(), 2);
+    EXPECT_EQ(extracted.depth(3), 2);
+    std::vector<std::string> values;
+    for (auto it = extracted.pre_order_begin(); it != extracted.pre_order_end(); ++it) {
+        values.push_back(it->value());
+    }
+    EXPECT_EQ(values, std::vector<std::string>({"1", "3", "4", "7"}));
+
+    EXPECT_EQ(tree.liveSize(), 4);
+    EXPECT_TRUE(tree.isRemoved(1));
+    EXPECT_EQ(std::vector<size_t>(tree.getRoot().edges().begin(), tree.getRoot().edges().end()),
+              std::vector<size_t>({2}));
+    EXPECT_THROW(tree.extractSubtree(0), std::invalid_argument);
+    EXPECT_THROW(tree.extractSubtree(1), std::invalid_argument);
+}
+
+TEST_F(LightweightTreeTest, TestKeepOnlySubtree) {
+    tree.addChild(5, "7");
+    std::vector<size_t> remap = tree.keepOnlySubtree(2);
+
+    EXPECT_EQ(remap, std::vector<size_t>({static_cast<size_t>(-1), static_cast<size_t>(-1), 0,
+                                          static_cast<size_t>(-1), static_cast<size_t>(-1), 1, 2, 3}));
+    EXPECT_EQ(tree.size(), 4);
+    EXPECT_EQ(tree.liveSize(), 4);
+    EXPECT_EQ(tree.getRoot().value(), "2");
+    EXPECT_EQ(tree.getRoot().parentId(), 0);
+    EXPECT_EQ(tree.getNode(3).parentId(), 1);
+    EXPECT_EQ(tree.depth(3), 2);
+    EXPECT_EQ(std::vector<size_t>(tree.getRoot().edges().begin(), tree.getRoot().edges().end()),
+              std::vector<size_t>({1, 2}));
+    tree.addChild(0, "8");
+    EXPECT_EQ(tree.depth(4), 1);
+}
+
+TEST_F(LightweightTreeTest, TestGraft) {
+    lightweight::Tree<std::string> other("a");
+    size_t b = other.addChild(0, "b");
+    other.addChild(b, "c");
+    other.addChild(0, "d");
+    other.removeSubtree(3);
+
+    size_t root = tree.graft(6, std::move(other));
+    EXPECT_EQ(root, 7);
+    EXPECT_EQ(tree.size(), 10);
+    EXPECT_EQ(tree.getNode(7).parentId(), 6);
+    EXPECT_EQ(tree.getNode(9).value(), "c");
+    EXPECT_EQ(tree.getNode(9).parentId(), 8);
+    EXPECT_EQ(tree.depth(9), 5);
+    EXPECT_EQ(std::vector<size_t>(tree.getNode(6).edges().begin(), tree.getNode(6).edges().end()),
+              std::vector<size_t>({7}));
+
+    std::vector<std::string> values;
+    for (auto it = tree.post_order_begin(); it != tree.post_order_end(); ++it) {
+        values.push_back(it->value());
+    }
+    EXPECT_EQ(values, std::vector<std::string>({"3", "4", "1", "5", "c", "b", "a", "6", "2", "0"}));
+
+    lightweight::Tree<std::string> copy = tree.extractSubtree(7);
+    EXPECT_EQ(tree.graft(0, copy), 10);
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(tree.depth(12), 3);
+}
+
+TEST_F(LightweightTreeTest, TestSiblings) {
+    EXPECT_EQ(tree.childIndex(0), 0);
+    EXPECT_EQ(tree.childIndex(2), 1);
+    EXPECT_EQ(tree.childIndex(4), 1);
+    EXPECT_EQ(tree.nextSibling(3), 4);
+    EXPECT_EQ(tree.nextSibling(4), static_cast<size_t>(-1));
+    EXPECT_EQ(tree.prevSibling(6), 5);
+    EXPECT_EQ(tree.prevSibling(5), static_cast<size_t>(-1));
+    EXPECT_EQ(tree.nextSibling(0), static_cast<size_t>(-1));
+    EXPECT_THROW(tree.nextSibling(100), std::out_of_range);
+
+    size_t a = tree.addChild(0, "7");
+    size_t b = tree.addChild(0, "8");
+    EXPECT_EQ(tree.childIndex(b), 3);
+    tree.removeSubtree(2);
+    EXPECT_EQ(tree.childIndex(a), 1);
+    EXPECT_EQ(tree.childIndex(b), 2);
+    EXPECT_EQ(tree.nextSibling(1), a);
+    EXPECT_EQ(tree.prevSibling(b), a);
+    EXPECT_EQ(tree.nextSibling(5), static_cast<size_t>(-1));
+
+    tree.compact();
+    EXPECT_EQ(tree.childIndex(4), 1);
+    EXPECT_EQ(tree.nextSibling(4), 5);
+
+    auto extracted = tree.extractSubtree(1);
+    EXPECT_EQ(extracted.nextSibling(1), 2);
+    EXPECT_EQ(extracted.childIndex(0), 0);
+    EXPECT_EQ(tree.childIndex(4), 0);
+    EXPECT_EQ(tree.childIndex(tree.graft(0, extracted)), 2);
+}
+
+TEST_F(LightweightTreeTest, TestAncestors) {
+    size_t deep = tree.addChild(6, "7");
+    std::vector<std::string> values;
+    for (const Node& node : tree.ancestors(deep)) {
+        values.push_back(node.value());
+    }
+    EXPECT_EQ(values, std::vector<std::string>({"6", "2", "0"}));
+    EXPECT_TRUE(tree.ancestors(0).empty());
+
+    const Tree& constTree = tree;
+    EXPECT_EQ(std::distance(constTree.ancestors(deep).begin(), constTree.ancestors(deep).end()), 3);
+}
+
 #endif // LIGHTWEIGHT_TREE_TEST_HPP
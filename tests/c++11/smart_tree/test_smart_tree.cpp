@@ -79,4 +79,35 @@ TEST_F(SmartTreeTest, TestShouldNotCompile) {
 }
 */
 
+TEST_F(SmartTreeTest, TestDepthAfterCopy) {
+    size_t grandchild = tree.getNode(3).addChild("7");
+    EXPECT_EQ(tree.depth(grandchild), 3);
+
+    Tree copy("x");
+    copy = tree;
+    EXPECT_EQ(copy.depth(grandchild), 3);
+    EXPECT_EQ(copy.depth(copy.getNode(grandchild).addChild("8")), 4);
+}
+
+TEST_F(SmartTreeTest, TestExtractAndGraft) {
+    Tree extracted = tree.extractSubtree(1);
+    EXPECT_EQ(extracted.getRoot().value(), "1");
+    size_t child = extracted.getRoot().addChild("x");
+    EXPECT_EQ(extracted.getNode(child).parentId(), 0);
+    EXPECT_EQ(extracted.getRoot().getChildren().size(), 3);
+
+    size_t root = tree.graft(2, extracted);
+    EXPECT_EQ(tree.getNode(root).getChildren().size(), 3);
+    size_t grandchild = tree.getNode(root).addChild("y");
+    EXPECT_EQ(tree.depth(grandchild), 3);
+    EXPECT_EQ(extracted.size(), 4);
+}
+
+TEST_F(SmartTreeTest, TestSiblings) {
+    auto& child = tree.getNode(3);
+    EXPECT_EQ(child.childIndex(), 0);
+    EXPECT_EQ(child.nextSibling(), 4);
+    EXPECT_EQ(child.prevSibling(), static_cast<size_t>(-1));
+}
+
 #endif // LIGHTWEIGHT_TREE_TEST_HPP
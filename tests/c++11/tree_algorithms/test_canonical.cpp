@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <random>
+#include "canonical.hpp"
+#include "lightweight_tree.hpp"
+
+using namespace vpr;
+using algorithms::CanonicalDictionary;
+using Tree = lightweight::Tree<int>;
+
+/**
+ * @brief Builds the same random shape with the children of every node inserted in random order.
+ *
+ * The node values are the positions of the nodes in the original insertion order.
+ */
+Tree shuffledCopy(const std::vector<size_t>& parents, unsigned seed) {
+    const size_t n = parents.size();
+    std::vector<std::vector<size_t>> children(n);
+    for (size_t i = 1; i < n; ++i) {
+        children[parents[i]].push_back(i);
+    }
+    std::mt19937 rng(seed);
+    Tree tree(0);
+    std::vector<size_t> stack(1, 0);
+    std::vector<size_t> index(n, 0);
+    while (!stack.empty()) {
+        size_t node = stack.back();
+        stack.pop_back();
+        std::shuffle(children[node].begin(), children[node].end(), rng);
+        for (size_t child : children[node]) {
+            index[child] = tree.addChild(index[node], static_cast<int>(child));
+            stack.push_back(child);
+        }
+    }
+    return tree;
+}
+
+TEST(CanonicalTest, ChildOrderDoesNotMatter) {
+    std::mt19937 rng(4);
+    std::vector<size_t> parents(1, 0);
+    for (size_t i = 1; i < 2000; ++i) {
+        parents.push_back(std::uniform_int_distribution<size_t>(0, i - 1)(rng));
+    }
+    Tree first = shuffledCopy(parents, 1);
+    Tree second = shuffledCopy(parents, 2);
+
+    EXPECT_TRUE(algorithms::isIsomorphic(first, second));
+    EXPECT_TRUE(algorithms::isIsomorphic(first, second, std::hash<int>()));
+    EXPECT_EQ(algorithms::subtreeHashes(first)[0], algorithms::subtreeHashes(second)[0]);
+
+    second.getNode(second.size() - 1).value() = -1;
+    EXPECT_TRUE(algorithms::isIsomorphic(first, second));
+    EXPECT_FALSE(algorithms::isIsomorphic(first, second, std::hash<int>()));
+    EXPECT_NE(algorithms::subtreeHashes(first, std::hash<int>())[0],
+              algorithms::subtreeHashes(second, std::hash<int>())[0]);
+}
+
+TEST(CanonicalTest, DifferentShapes) {
+    // Four nodes each: a chain versus a root with branches of length two and one.
+    Tree path(0);
+    path.addChild(path.addChild(path.addChild(0, 1), 2), 3);
+    Tree fork(0);
+    fork.addChild(fork.addChild(0, 1), 2);
+    fork.addChild(0, 3);
+
+    EXPECT_FALSE(algorithms::isIsomorphic(path, fork));
+    EXPECT_NE(algorithms::subtreeHashes(path)[0], algorithms::subtreeHashes(fork)[0]);
+}
+
+TEST(CanonicalTest, SharedDictionaryAcrossTrees) {
+    CanonicalDictionary<> dictionary;
+    Tree a(0);
+    a.addChild(0, 1);
+    a.addChild(0, 2);
+    Tree b(5);
+    b.addChild(0, 6);
+    b.addChild(0, 7);
+    Tree c(0);
+    c.addChild(c.addChild(0, 1), 2);
+
+    size_t idA = dictionary.canonicalId(a);
+    EXPECT_EQ(dictionary.canonicalId(b), idA);
+    EXPECT_NE(dictionary.canonicalId(c), idA);
+    // Leaf, root with two leaves, chain of two, chain of three.
+    EXPECT_EQ(dictionary.size(), 4u);
+}
+
+TEST(CanonicalTest, DedupSubtrees) {
+    Tree tree(0);
+    size_t a = tree.addChild(0, 1);
+    size_t b = tree.addChild(0, 1);
+    size_t a1 = tree.addChild(a, 2);
+    size_t b1 = tree.addChild(b, 2);
+    size_t c = tree.addChild(0, 1);
+    tree.removeSubtree(c);
+
+    std::vector<size_t> representative = algorithms::dedupSubtrees(tree, std::hash<int>());
+    EXPECT_EQ(representative[0], 0u);
+    EXPECT_EQ(representative[a], a);
+    EXPECT_EQ(representative[b], a);
+    EXPECT_EQ(representative[a1], a1);
+    EXPECT_EQ(representative[b1], a1);
+    EXPECT_EQ(representative[c], static_cast<size_t>(-1));
+}
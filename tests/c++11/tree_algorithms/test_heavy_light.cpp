@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "heavy_light.hpp"
+#include "lightweight_tree.hpp"
+
+using namespace vpr;
+using algorithms::HeavyLightDecomposition;
+using algorithms::PathAggregate;
+using Tree = lightweight::Tree<int>;
+
+/**
+ * @brief Builds a random tree with `n` nodes, using a fixed seed.
+ */
+Tree randomDeepTree(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    Tree tree(0);
+    for (size_t i = 1; i < n; ++i) {
+        std::uniform_int_distribution<size_t> pick(i > 30 ? i - 30 : 0, i - 1);
+        tree.addChild(pick(rng), static_cast<int>(i));
+    }
+    return tree;
+}
+
+/**
+ * @brief Reference path sum walking `parentId()` one hop at a time.
+ */
+long naivePathSum(const Tree& tree, const std::vector<long>& values, size_t u, size_t v) {
+    long sum = 0;
+    while (tree.depth(u) > tree.depth(v)) {
+        sum += values[u];
+        u = tree.getNode(u).parentId();
+    }
+    while (tree.depth(v) > tree.depth(u)) {
+        sum += values[v];
+        v = tree.getNode(v).parentId();
+    }
+    while (u != v) {
+        sum += values[u] + values[v];
+        u = tree.getNode(u).parentId();
+        v = tree.getNode(v).parentId();
+    }
+    return sum + values[u];
+}
+
+TEST(HeavyLightTest, ChainIsOneRange) {
+    Tree tree(0);
+    for (size_t i = 1; i < 100; ++i) {
+        tree.addChild(i - 1, static_cast<int>(i));
+    }
+    HeavyLightDecomposition<Tree> hld(tree);
+    auto ranges = hld.rootPathRanges(99);
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0].begin, 0u);
+    EXPECT_EQ(ranges[0].end, 100u);
+    EXPECT_EQ(hld.chainHead(99), 0u);
+    EXPECT_EQ(hld.lca(40, 70), 40u);
+}
+
+TEST(HeavyLightTest, RangesCoverPathExactly) {
+    Tree tree = randomDeepTree(2000, 5);
+    HeavyLightDecomposition<Tree> hld(tree);
+    ASSERT_EQ(hld.size(), tree.size());
+
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<size_t> pick(0, tree.size() - 1);
+    for (int i = 0; i < 200; ++i) {
+        size_t u = pick(rng);
+        size_t v = pick(rng);
+        size_t length = 0;
+        for (const auto& range : hld.pathRanges(u, v)) {
+            length += range.end - range.begin;
+        }
+        size_t lca = hld.lca(u, v);
+        EXPECT_EQ(length, tree.depth(u) + tree.depth(v) - 2 * tree.depth(lca) + 1);
+        EXPECT_LE(hld.pathRanges(u, v).size(), 2 * 12u);
+    }
+}
+
+TEST(HeavyLightTest, SubtreesAreContiguous) {
+    Tree tree = randomDeepTree(500, 3);
+    HeavyLightDecomposition<Tree> hld(tree);
+    for (size_t node = 1; node < tree.size(); ++node) {
+        auto parent = hld.subtreeRange(tree.getNode(node).parentId());
+        auto child = hld.subtreeRange(node);
+        EXPECT_LE(parent.begin, child.begin);
+        EXPECT_GE(parent.end, child.end);
+        EXPECT_EQ(hld.nodeAt(hld.position(node)), node);
+    }
+}
+
+TEST(HeavyLightTest, PathAggregateMatchesNaive) {
+    Tree tree = randomDeepTree(3000, 17);
+    std::vector<long> values(tree.size());
+    PathAggregate<Tree, long> sums(tree);
+    for (size_t node = 0; node < tree.size(); ++node) {
+        values[node] = static_cast<long>(node % 97) - 40;
+        sums.set(node, values[node]);
+    }
+
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<size_t> pick(0, tree.size() - 1);
+    for (int i = 0; i < 300; ++i) {
+        size_t u = pick(rng);
+        size_t v = pick(rng);
+        if (i % 10 == 0) {
+            values[u] = i;
+            sums.set(u, values[u]);
+        }
+        ASSERT_EQ(sums.pathQuery(u, v), naivePathSum(tree, values, u, v));
+    }
+    long total = 0;
+    for (long value : values) {
+        total += value;
+    }
+    EXPECT_EQ(sums.subtreeQuery(0), total);
+}
+
+TEST(HeavyLightTest, MaxAggregateAndRemovedNodes) {
+    Tree tree(0);
+    size_t a = tree.addChild(0, 1);
+    size_t b = tree.addChild(a, 2);
+    size_t c = tree.addChild(0, 3);
+    size_t d = tree.addChild(c, 4);
+    tree.removeSubtree(a);
+
+    struct Max {
+        int operator()(int x, int y) const { return std::max(x, y); }
+    };
+    PathAggregate<Tree, int, Max> maxima(tree, 0, Max());
+    maxima.set(0, 5);
+    maxima.set(c, 2);
+    maxima.set(d, 7);
+    EXPECT_EQ(maxima.pathQuery(0, c), 5);
+    EXPECT_EQ(maxima.pathQuery(0, d), 7);
+    EXPECT_THROW(maxima.set(b, 1), std::out_of_range);
+    EXPECT_THROW(maxima.pathQuery(b, d), std::out_of_range);
+}
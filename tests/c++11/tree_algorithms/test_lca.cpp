@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "lca.hpp"
+#include "lightweight_tree.hpp"
+#include "smart_tree.hpp"
+
+using namespace vpr;
+using algorithms::LcaStrategy;
+using algorithms::LowestCommonAncestor;
+
+/**
+ * @brief Builds a random recursive tree with `n` nodes, using a fixed seed.
+ */
+lightweight::Tree<int> randomTree(size_t n, unsigned seed) {
+    lightweight::Tree<int> tree(0);
+    std::mt19937 rng(seed);
+    for (size_t i = 1; i < n; ++i) {
+        std::uniform_int_distribution<size_t> pick(0, i - 1);
+        tree.addChild(pick(rng), static_cast<int>(i));
+    }
+    return tree;
+}
+
+/**
+ * @brief Reference LCA walking parent chains.
+ */
+template <typename TreeType>
+size_t naiveLca(const TreeType& tree, size_t u, size_t v) {
+    std::vector<bool> ancestor(tree.size(), false);
+    for (size_t x = u; ; x = tree.getNode(x).parentId()) {
+        ancestor[x] = true;
+        if (x == 0) break;
+    }
+    for (size_t x = v; ; x = tree.getNode(x).parentId()) {
+        if (ancestor[x]) return x;
+    }
+}
+
+class LcaTest : public ::testing::TestWithParam<LcaStrategy> { };
+
+TEST_P(LcaTest, SmallTree) {
+    /*
+             0
+           /   \
+          1     2
+         / \     \
+        3   4     5
+       /
+      6
+    */
+    lightweight::Tree<int> tree(0);
+    tree.addChild(0, 1);
+    tree.addChild(0, 2);
+    tree.addChild(1, 3);
+    tree.addChild(1, 4);
+    tree.addChild(2, 5);
+    tree.addChild(3, 6);
+
+    LowestCommonAncestor<lightweight::Tree<int>> lca(tree, GetParam());
+    EXPECT_EQ(lca.strategy(), GetParam());
+    EXPECT_EQ(lca.query(6, 4), 1);
+    EXPECT_EQ(lca.query(4, 6), 1);
+    EXPECT_EQ(lca.query(6, 5), 0);
+    EXPECT_EQ(lca.query(3, 6), 3);
+    EXPECT_EQ(lca.query(2, 2), 2);
+    EXPECT_EQ(lca.query(0, 6), 0);
+    EXPECT_EQ(lca.depth(6), 3);
+    EXPECT_THROW(lca.query(0, 7), std::out_of_range);
+}
+
+TEST_P(LcaTest, MatchesNaiveOnRandomTree) {
+    auto tree = randomTree(3000, 5);
+    LowestCommonAncestor<lightweight::Tree<int>> lca(tree, GetParam());
+
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<size_t> pick(0, tree.size() - 1);
+    std::vector<std::pair<size_t, size_t>> pairs;
+    std::vector<size_t> expected;
+    for (int i = 0; i < 2000; ++i) {
+        pairs.push_back(std::make_pair(pick(rng), pick(rng)));
+        expected.push_back(naiveLca(tree, pairs.back().first, pairs.back().second));
+    }
+    EXPECT_EQ(lca.query(pairs), expected);
+}
+
+TEST_P(LcaTest, DeepChain) {
+    lightweight::Tree<int> tree(0);
+    for (size_t i = 1; i < 5000; ++i) {
+        tree.addChild(i - 1, static_cast<int>(i));
+    }
+    LowestCommonAncestor<lightweight::Tree<int>> lca(tree, GetParam());
+    EXPECT_EQ(lca.query(4999, 1234), 1234);
+    EXPECT_EQ(lca.depth(4999), 4999);
+}
+
+TEST_P(LcaTest, RemovedNodesAreNotIndexed) {
+    smart::Tree<int> tree(0);
+    size_t a = tree.addChild(0, 1);
+    size_t b = tree.addChild(0, 2);
+    size_t c = tree.addChild(a, 3);
+    size_t d = tree.addChild(b, 4);
+    tree.removeSubtree(a);
+
+    LowestCommonAncestor<smart::Tree<int>> lca(tree, GetParam());
+    EXPECT_EQ(lca.query(d, 0), 0);
+    EXPECT_THROW(lca.query(c, d), std::out_of_range);
+}
+
+INSTANTIATE_TEST_SUITE_P(Strategies, LcaTest,
+                         ::testing::Values(LcaStrategy::EulerTour, LcaStrategy::BinaryLifting));
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "level_ancestor.hpp"
+#include "lightweight_tree.hpp"
+
+using namespace vpr;
+using algorithms::LevelAncestor;
+using Tree = lightweight::Tree<int>;
+
+/**
+ * @brief Reference level ancestor walking `k` parent links.
+ */
+size_t naiveAncestor(const Tree& tree, size_t node, size_t k) {
+    while (k-- > 0) {
+        node = tree.getNode(node).parentId();
+    }
+    return node;
+}
+
+TEST(LevelAncestorTest, DeepChain) {
+    Tree tree(0);
+    for (size_t i = 1; i < 10000; ++i) {
+        tree.addChild(i - 1, static_cast<int>(i));
+    }
+    LevelAncestor<Tree> index(tree);
+    EXPECT_EQ(index.ancestor(9999, 0), 9999);
+    EXPECT_EQ(index.ancestor(9999, 1), 9998);
+    EXPECT_EQ(index.ancestor(9999, 9999), 0);
+    EXPECT_EQ(index.ancestor(5000, 1234), 3766);
+    EXPECT_EQ(index.ancestorAtDepth(9999, 10), 10);
+    EXPECT_THROW(index.ancestor(10, 11), std::out_of_range);
+    EXPECT_THROW(index.ancestor(10000, 0), std::out_of_range);
+}
+
+TEST(LevelAncestorTest, MatchesNaiveOnRandomTrees) {
+    for (unsigned seed = 1; seed <= 3; ++seed) {
+        std::mt19937 rng(seed);
+        Tree tree(0);
+        for (size_t i = 1; i < 3000; ++i) {
+            // Bias towards recent nodes to get deep, bushy trees.
+            std::uniform_int_distribution<size_t> pick(i > 20 ? i - 20 : 0, i - 1);
+            tree.addChild(pick(rng), static_cast<int>(i));
+        }
+        LevelAncestor<Tree> index(tree);
+        for (size_t node = 0; node < tree.size(); ++node) {
+            for (size_t k = 0; k <= tree.depth(node); k += 1 + k / 3) {
+                ASSERT_EQ(index.ancestor(node, k), naiveAncestor(tree, node, k)) << node << " " << k;
+            }
+        }
+    }
+}
+
+TEST(LevelAncestorTest, SkipsRemovedNodes) {
+    Tree tree(0);
+    size_t a = tree.addChild(0, 1);
+    size_t b = tree.addChild(a, 2);
+    size_t c = tree.addChild(0, 3);
+    size_t d = tree.addChild(c, 4);
+    tree.removeSubtree(a);
+
+    LevelAncestor<Tree> index(tree);
+    EXPECT_EQ(index.ancestor(d, 2), 0);
+    EXPECT_THROW(index.ancestor(b, 1), std::out_of_range);
+}